@@ -0,0 +1,63 @@
+/*
+ * Cache Eviction Policy Header
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * Shared by the maps that support a bounded cache mode (linear probing
+ * and cuckoo). Each slot carries a 32-bit access word next to the table:
+ * under CLOCK it is the reference bit, under sampled LRU a logical time
+ * stamp. A full cache never grows; inserting a new key first evicts the
+ * slot the policy picks.
+ *  - CLOCK: Corbato, F. J. (1968). A paging experiment with the Multics
+ *    system. MIT Project MAC Report MAC-M-384.
+ *  - Sampled LRU: the approximation used by Redis (maxmemory-policy
+ *    allkeys-lru), evicting the oldest of a few random keys.
+ */
+
+#ifndef CACHE_POLICY_H // Include guard
+#define CACHE_POLICY_H // Prevent multiple inclusions
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Slots sampled per eviction by CACHE_SAMPLED_LRU
+#define CACHE_LRU_SAMPLES 5
+
+// Eviction policy of a map created in cache mode
+typedef enum {
+    CACHE_NONE = 0,     // Plain map: no access words, no eviction
+    CACHE_CLOCK,        // Second chance sweep over reference bits set by get
+    CACHE_SAMPLED_LRU   // Oldest of CACHE_LRU_SAMPLES random occupied slots
+} CachePolicy;
+
+// Access word for a slot that was just read or written
+// tick is the map's logical clock (wraps after 2^32 accesses, which only
+// makes a few old keys look recent for one round of sampling)
+static inline uint32_t cache_touch(CachePolicy policy, uint32_t *tick) {
+    return policy == CACHE_CLOCK ? 1u : ++*tick;
+}
+
+// Access word for a newly inserted key: CLOCK admits it unreferenced, so
+// only a later get protects it from the sweep; LRU stamps it now
+static inline uint32_t cache_admit(CachePolicy policy, uint32_t *tick) {
+    return policy == CACHE_CLOCK ? 0u : ++*tick;
+}
+
+// Whether access word a marks a colder (better to evict) key than b
+// Unsigned ages keep LRU comparisons right across tick wrap around
+static inline bool cache_colder(CachePolicy policy, uint32_t tick, uint32_t a,
+                                uint32_t b) {
+    return policy == CACHE_CLOCK ? a < b : tick - a > tick - b;
+}
+
+// Name of a policy for reports
+static inline const char* cache_policy_name(CachePolicy policy) {
+    switch (policy) {
+        case CACHE_CLOCK:       return "clock";
+        case CACHE_SAMPLED_LRU: return "sampled-lru";
+        default:                return "none";
+    }
+}
+
+#endif
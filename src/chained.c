@@ -3,11 +3,25 @@
  * Name: Siddharth Kakked
  * Semester: Fall 2025
  * Class: CS 5008
+ *
+ * Keys are hashed with a per-map random seed, so colliding keys cannot be
+ * precomputed. If an insert still walks a chain far longer than the load
+ * explains (the seed leaked, or was chosen by the caller), the map draws a
+ * new seed and relinks every node in place, as cuckoo_rehash does.
+ *
+ * Built with HASHMAP_TTL, every node carries a deadline. An expired node
+ * is unlinked by the first lookup that reaches it, and chained_expire_step
+ * sweeps a few buckets per call for nodes nobody asks for again.
  */
 
+#define _POSIX_C_SOURCE 200112L // clock_gettime
+
 #include "chained.h"
+#include "hash_simd.h"
+#include "parallel.h"
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <stdbool.h>
 
 /* Takes a key and capacity, returns bucket index
@@ -16,8 +30,9 @@
 * The bit-mixing sequence and associated constants in the hash_with_seed function 
 * were adapted from the fmix32() finalizer of MurmurHash3.
 */ 
-static size_t hash(int key, size_t capacity) {
+static size_t hash(int key, unsigned int seed, size_t capacity) {
     unsigned int k = (unsigned int)key;  // Convert to unsigned for bitwise ops
+    k ^= seed;           // Mix in the per-map seed
     k ^= (k >> 16);      // Mix high bits into low bits
     k *= 0x85ebca6b;     // Multiply by magic constant
     k ^= (k >> 13);      // More bit mixing
@@ -28,6 +43,11 @@ static size_t hash(int key, size_t capacity) {
 
 // Create a new chained hash map with specified capacity
 ChainedHashMap* chained_create(size_t capacity) {
+    return chained_create_with(capacity, NULL);
+}
+
+// Create a new chained hash map with creation options
+ChainedHashMap* chained_create_with(size_t capacity, const ChainedOptions *opts) {
     // Allocate the main structure
     ChainedHashMap *map = malloc(sizeof(ChainedHashMap));
     if (!map) return NULL;  // Allocation failed
@@ -41,6 +61,23 @@ ChainedHashMap* chained_create(size_t capacity) {
     
     map->capacity = capacity;  // Store capacity
     map->size = 0;             // Initially empty
+    map->max_chain = (opts && opts->max_chain) ? opts->max_chain
+                                               : CHAINED_FLOOD_CHAIN;
+    map->reseed_guard = 0;
+    map->reseed_count = 0;
+    map->resize_threads = opts ? opts->resize_threads : 0;
+#ifdef HASHMAP_STATS
+    memset(&map->stats, 0, sizeof(map->stats));  // Counters start at zero
+#endif
+#ifdef HASHMAP_TTL
+    map->now = 0;
+    map->sweep_cursor = 0;
+#endif
+    
+    // Per-map generator: reproducible when the caller passes a seed
+    uint64_t seed = (opts && opts->seed) ? opts->seed : prng_default_seed(map);
+    prng_seed(&map->rng, seed);
+    map->seed = (unsigned int)prng_next(&map->rng);
     return map;                // Return the new map
 }
 
@@ -62,73 +99,388 @@ void chained_destroy(ChainedHashMap *map) {
     free(map);           // Free the main structure
 }
 
-// Insert or update a key value pair
-bool chained_put(ChainedHashMap *map, int key, int value) {
-    if (!map) return false;  // Handle NULL input
+// Remove every entry but keep the bucket array for reuse
+void chained_clear(ChainedHashMap *map) {
+    if (!map) return;
+    
+    // Only walk buckets while nodes remain
+    for (size_t i = 0; i < map->capacity && map->size > 0; i++) {
+        ChainedNode *node = map->buckets[i];
+        while (node) {
+            ChainedNode *next = node->next;  // Save next before freeing
+            free(node);
+            map->size--;
+            node = next;
+        }
+        map->buckets[i] = NULL;
+    }
+    map->size = 0;
+    map->reseed_guard = 0;
+#ifdef HASHMAP_TTL
+    map->sweep_cursor = 0;
+#endif
+}
+
+#ifdef HASHMAP_STATS
+// Wall clock in milliseconds, for resize timing (clock() would add up
+// the CPU time of every migration thread)
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+#endif
+
+// Draw a new seed and move every node to its new bucket
+// Nodes are relinked, not reallocated, so this cannot fail
+static void chained_reseed(ChainedHashMap *map) {
+#ifdef HASHMAP_STATS
+    double rebuild_start = now_ms();  // Counted as resize time
+#endif
+    // Unhook every chain into one list
+    ChainedNode *all = NULL;
+    for (size_t i = 0; i < map->capacity; i++) {
+        ChainedNode *node = map->buckets[i];
+        while (node) {
+            ChainedNode *next = node->next;
+            node->next = all;
+            all = node;
+            node = next;
+        }
+        map->buckets[i] = NULL;
+    }
+    
+    // New seed, different from the one that was flooded
+    unsigned int old_seed = map->seed;
+    do {
+        map->seed = (unsigned int)prng_next(&map->rng);
+    } while (map->seed == old_seed);
+    
+    // Push every node onto the head of its new chain,
+    // hashing HASH_BATCH keys at a time
+    while (all) {
+        ChainedNode *nodes[HASH_BATCH];
+        int keys[HASH_BATCH];
+        unsigned int h[HASH_BATCH];
+        size_t count = 0;
+        for (; all && count < HASH_BATCH; all = all->next) {
+            nodes[count] = all;
+            keys[count++] = all->key;
+        }
+        hash_batch(keys, map->seed, h, count);
+        for (size_t i = 0; i < count; i++) {
+            size_t idx = h[i] % map->capacity;
+            nodes[i]->next = map->buckets[idx];
+            map->buckets[idx] = nodes[i];
+        }
+    }
+    map->reseed_count++;
+    // Reseed at most once per doubling, so each costs O(1) amortized
+    map->reseed_guard = map->size * 2;
+#ifdef HASHMAP_STATS
+    map->stats.resizes++;
+    map->stats.resize_ms += now_ms() - rebuild_start;
+#endif
+}
+
+// Unlink node (preceded by prev, or NULL at the head) from bucket idx
+static void chained_unlink(ChainedHashMap *map, size_t idx, ChainedNode *prev,
+                           ChainedNode *node) {
+    if (prev) {
+        prev->next = node->next;  // Bypass current node
+    } else {
+        map->buckets[idx] = node->next;  // Update bucket head
+    }
+    free(node);   // Free the node
+    map->size--;  // Decrement count
+}
+
+// Link a new node for a key known to be absent at the head of bucket idx
+// chain is the bucket's length including the new node
+// Returns the node (a flood reseed relinks it but never moves it), or NULL
+static ChainedNode* chained_link_new(ChainedHashMap *map, int key, int value,
+                                     size_t idx, uint64_t expires,
+                                     size_t chain) {
+    ChainedNode *new_node = malloc(sizeof(ChainedNode));
+    if (!new_node) return NULL;  // Allocation failed
     
-    size_t idx = hash(key, map->capacity);  // Find bucket
+    // Initialize new node
+    new_node->key = key;
+    new_node->value = value;
+    TTL_SET(new_node, expires);
+    new_node->next = map->buckets[idx];  // Insert at head of chain
+    map->buckets[idx] = new_node;        // Update bucket head
+    map->size++;                          // Increment count
+    
+    // Flood check: threshold scales with the average chain length
+    size_t limit = map->max_chain;
+    if (limit < SIZE_MAX / 2) limit *= 1 + map->size / map->capacity;
+    if (chain > limit && map->size > map->reseed_guard) {
+        chained_reseed(map);
+    }
+    return new_node;
+}
+
+// Insert or update a key value pair whose bucket is already known
+// expires is the node's deadline (ignored without HASHMAP_TTL)
+static bool chained_put_hashed(ChainedHashMap *map, int key, int value,
+                               size_t idx, uint64_t expires) {
     ChainedNode *node = map->buckets[idx];
+    size_t chain = 1;  // Length of this chain once the key is added
     
     // Search chain for existing key
     while (node) {
+        STAT_INC(map, probes);
         if (node->key == key) {
             node->value = value;  // Update existing value
+            TTL_SET(node, expires);
             return true;
         }
         node = node->next;
+        chain++;
     }
     
     // Key not found, create new node
-    ChainedNode *new_node = malloc(sizeof(ChainedNode));
-    if (!new_node) return false;  // Allocation failed
+    return chained_link_new(map, key, value, idx, expires, chain) != NULL;
+}
+
+// Insert or update a key value pair
+bool chained_put(ChainedHashMap *map, int key, int value) {
+    if (!map) return false;  // Handle NULL input
+    size_t idx = hash(key, map->seed, map->capacity);  // Find bucket
+    return chained_put_hashed(map, key, value, idx, TTL_NEVER);
+}
+
+// Return the value slot of key, inserting it with value 0 if absent, so
+// read-modify-write updates walk the chain once. *inserted (if not NULL)
+// tells whether the key is new. Nodes never move, so the pointer stays
+// valid until the key is deleted or the map is cleared or destroyed
+int* chained_find_or_insert(ChainedHashMap *map, int key, bool *inserted) {
+    if (inserted) *inserted = false;
+    if (!map) return NULL;
     
-    // Initialize new node
-    new_node->key = key;
-    new_node->value = value;
-    new_node->next = map->buckets[idx];  // Insert at head of chain
-    map->buckets[idx] = new_node;        // Update bucket head
-    map->size++;                          // Increment count
+    size_t idx = hash(key, map->seed, map->capacity);
+    size_t chain = 1;  // Length of this chain once the key is added
+    for (ChainedNode *node = map->buckets[idx]; node; node = node->next) {
+        STAT_INC(map, probes);
+        chain++;
+        if (node->key == key) {
+            if (TTL_EXPIRED(map, node)) {
+                // Expired: starts over as a new key
+                node->value = 0;
+                TTL_SET(node, TTL_NEVER);
+                if (inserted) *inserted = true;
+                STAT_INC(map, misses);
+                return &node->value;
+            }
+            STAT_INC(map, hits);
+            return &node->value;
+        }
+    }
+    STAT_INC(map, misses);
+    
+    // Absent: link a new node without walking the chain again
+    ChainedNode *node = chained_link_new(map, key, 0, idx, TTL_NEVER, chain);
+    if (!node) return NULL;
+    if (inserted) *inserted = true;
+    return &node->value;
+}
+
+// Add delta to the value of key, which starts at 0 if absent
+bool chained_add(ChainedHashMap *map, int key, int delta) {
+    int *slot = chained_find_or_insert(map, key, NULL);
+    if (!slot) return false;
+    *slot += delta;
     return true;
 }
 
-// Retrieve value for a key
-bool chained_get(ChainedHashMap *map, int key, int *value) {
-    if (!map) return false;  // Handle NULL input
+// Insert n pairs, hashing each group of HASH_BATCH keys in one pass
+// Returns the number of pairs stored
+size_t chained_put_batch(ChainedHashMap *map, const int *keys,
+                         const int *values, size_t n) {
+    if (!map || !keys || !values) return 0;
     
-    size_t idx = hash(key, map->capacity);  // Find bucket
+    size_t stored = 0;
+    unsigned int h[HASH_BATCH];
+    for (size_t base = 0; base < n; base += HASH_BATCH) {
+        size_t count = n - base < HASH_BATCH ? n - base : HASH_BATCH;
+        unsigned int seed = map->seed;
+        hash_batch(keys + base, seed, h, count);
+        for (size_t i = 0; i < count; i++) {
+            // A flood reseed moves every key: rehash the rest
+            if (map->seed != seed) {
+                seed = map->seed;
+                hash_batch(keys + base + i, seed, h + i, count - i);
+            }
+            if (chained_put_hashed(map, keys[base + i], values[base + i],
+                                   h[i] % map->capacity, TTL_NEVER)) {
+                stored++;
+            }
+        }
+    }
+    return stored;
+}
+
+// Retrieve value for a key whose bucket is already known
+// An expired node is a miss and is reclaimed on the spot
+static bool chained_get_hashed(ChainedHashMap *map, int key, int *value,
+                               size_t idx) {
     ChainedNode *node = map->buckets[idx];
+    ChainedNode *prev = NULL;
     
     // Search chain for key
     while (node) {
+        STAT_INC(map, probes);
         if (node->key == key) {
+            if (TTL_EXPIRED(map, node)) {
+                chained_unlink(map, idx, prev, node);
+                break;
+            }
             if (value) *value = node->value;  // Return value if pointer provided
+            STAT_INC(map, hits);
             return true;  // Found
         }
+        prev = node;
         node = node->next;
     }
+    STAT_INC(map, misses);
     return false;  // Not found
 }
 
+// Retrieve value for a key
+bool chained_get(ChainedHashMap *map, int key, int *value) {
+    if (!map) return false;  // Handle NULL input
+    size_t idx = hash(key, map->seed, map->capacity);  // Find bucket
+    return chained_get_hashed(map, key, value, idx);
+}
+
+// Look up n keys, hashing each group of HASH_BATCH keys in one pass
+// values[i] (if values is not NULL) is set and found[i] (if found is not
+// NULL) tells whether keys[i] was present. Returns the number found
+size_t chained_get_batch(ChainedHashMap *map, const int *keys, int *values,
+                         bool *found, size_t n) {
+    if (!map || !keys) return 0;
+    
+    size_t hits = 0;
+    unsigned int h[HASH_BATCH];
+    for (size_t base = 0; base < n; base += HASH_BATCH) {
+        size_t count = n - base < HASH_BATCH ? n - base : HASH_BATCH;
+        hash_batch(keys + base, map->seed, h, count);
+        for (size_t i = 0; i < count; i++) {
+            bool hit = chained_get_hashed(map, keys[base + i],
+                                          values ? &values[base + i] : NULL,
+                                          h[i] % map->capacity);
+            if (found) found[base + i] = hit;
+            if (hit) hits++;
+        }
+    }
+    return hits;
+}
+
+// One in-flight lookup of chained_get_interleaved
+typedef struct {
+    size_t i;           // Position of the key in the batch
+    size_t idx;         // Bucket of the key
+    ChainedNode *node;  // Node to compare next, NULL until the bucket is read
+} AmacLane;
+
+// Start lane on keys[i]: hash it and prefetch its bucket slot
+static void amac_start(ChainedHashMap *map, AmacLane *lane, const int *keys,
+                       size_t i) {
+    lane->i = i;
+    lane->idx = hash(keys[i], map->seed, map->capacity);
+    lane->node = NULL;
+#ifdef __GNUC__
+    __builtin_prefetch(&map->buckets[lane->idx]);
+#endif
+}
+
+// Look up n keys with asynchronous memory access chaining (Kocberber et
+// al., VLDB 2015): up to CHAINED_AMAC_LANES lookups are explicit state
+// machines, each advanced one memory access per round while the prefetch
+// for its next bucket or node is in flight, so independent chain walks
+// overlap instead of serializing on each node->next miss. A finished lane
+// immediately takes the next key. Results match chained_get_batch, except
+// that expired keys are reported as misses without being freed (another
+// lane may be reading the same node)
+size_t chained_get_interleaved(ChainedHashMap *map, const int *keys,
+                               int *values, bool *found, size_t n) {
+    if (!map || !keys) return 0;
+    
+    AmacLane lanes[CHAINED_AMAC_LANES];
+    size_t active = 0;  // Lanes in use, packed at the front
+    size_t next = 0;    // Next key to start
+    size_t hits = 0;
+    while (active < CHAINED_AMAC_LANES && next < n) {
+        amac_start(map, &lanes[active++], keys, next++);
+    }
+    
+    while (active > 0) {
+        for (size_t l = 0; l < active;) {
+            AmacLane *lane = &lanes[l];
+            bool done = false;
+            bool hit = false;
+            if (!lane->node) {
+                // Bucket slot has arrived: fetch the head node
+                lane->node = map->buckets[lane->idx];
+                done = !lane->node;  // Empty bucket
+            } else {
+                // Node has arrived: compare, or move to the next one
+                ChainedNode *node = lane->node;
+                STAT_INC(map, probes);
+                if (node->key == keys[lane->i]) {
+                    done = true;
+                    hit = !TTL_EXPIRED(map, node);
+                    if (hit && values) values[lane->i] = node->value;
+                } else {
+                    lane->node = node->next;
+                    done = !lane->node;  // End of chain
+                }
+            }
+            
+            if (!done) {
+#ifdef __GNUC__
+                __builtin_prefetch(lane->node);
+#endif
+                l++;
+                continue;
+            }
+            if (hit) {
+                STAT_INC(map, hits);
+                hits++;
+            } else {
+                STAT_INC(map, misses);
+            }
+            if (found) found[lane->i] = hit;
+            // Reuse the lane for the next key, or retire it (the last
+            // active lane moves here and is advanced in this round)
+            if (next < n) {
+                amac_start(map, lane, keys, next++);
+                l++;
+            } else {
+                *lane = lanes[--active];
+            }
+        }
+    }
+    return hits;
+}
+
 // Delete a key from the map
 bool chained_delete(ChainedHashMap *map, int key) {
     if (!map) return false;  // Handle NULL input
     
-    size_t idx = hash(key, map->capacity);  // Find bucket
+    size_t idx = hash(key, map->seed, map->capacity);  // Find bucket
     ChainedNode *node = map->buckets[idx];
     ChainedNode *prev = NULL;  // Track previous node for unlinking
     
     // Search chain for key
     while (node) {
+        STAT_INC(map, probes);
         if (node->key == key) {
-            // Unlink node from chain
-            if (prev) {
-                prev->next = node->next;  // Bypass current node
-            } else {
-                map->buckets[idx] = node->next;  // Update bucket head
-            }
-            free(node);   // Free the node
-            map->size--;  // Decrement count
-            return true;
+            // An expired key is already gone, but its node is freed here
+            bool live = !TTL_EXPIRED(map, node);
+            chained_unlink(map, idx, prev, node);
+            return live;
         }
         prev = node; // Update previous
         node = node->next; // Move to next node
@@ -136,6 +488,109 @@ bool chained_delete(ChainedHashMap *map, int key) {
     return false;  // Key not found
 }
 
+// Shared state of one bucket array migration
+typedef struct {
+    ChainedHashMap *map;          // Already switched to the new capacity
+    ChainedNode **old;            // Bucket array being emptied
+    ChainedNode **fresh;          // Destination bucket array
+} ChainedMigration;
+
+// Relink the nodes of old buckets [begin, end) onto their new chains,
+// hashing HASH_BATCH keys at a time. With atomic set each node is pushed
+// with compare-and-swap on the head, so threads moving keys to the same
+// bucket never lose a node
+static void chained_migrate_range(ChainedMigration *m, size_t begin,
+                                  size_t end, bool atomic) {
+    ChainedNode *nodes[HASH_BATCH];
+    int keys[HASH_BATCH];
+    unsigned int h[HASH_BATCH];
+    size_t i = begin;
+    ChainedNode *node = begin < end ? m->old[begin] : NULL;
+    while (true) {
+        // Gather the next batch, continuing across buckets
+        size_t count = 0;
+        while (count < HASH_BATCH) {
+            if (!node) {
+                if (++i >= end) break;
+                node = m->old[i];
+                continue;
+            }
+            nodes[count] = node;
+            keys[count++] = node->key;
+            node = node->next;
+        }
+        if (count == 0) break;
+        
+        hash_batch(keys, m->map->seed, h, count);
+        for (size_t j = 0; j < count; j++) {
+            ChainedNode **head = &m->fresh[h[j] % m->map->capacity];
+#ifdef PARALLEL_ATOMICS
+            if (atomic) {
+                ChainedNode *first;
+                do {
+                    first = *head;
+                    nodes[j]->next = first;
+                } while (!PARALLEL_CAS(head, first, nodes[j]));
+                continue;
+            }
+#else
+            (void)atomic;
+#endif
+            nodes[j]->next = *head;
+            *head = nodes[j];
+        }
+    }
+}
+
+// parallel_for bodies: one thread, or several sharing the new array
+static void chained_migrate_serial(void *ctx, size_t begin, size_t end) {
+    chained_migrate_range(ctx, begin, end, false);
+}
+
+#ifdef PARALLEL_ATOMICS
+static void chained_migrate_parallel(void *ctx, size_t begin, size_t end) {
+    chained_migrate_range(ctx, begin, end, true);
+}
+#endif
+
+// Move every node onto a bucket array of new_capacity chains
+// Nodes are relinked, not copied; large tables are split over
+// resize_threads threads. Fails (map unchanged) if the array cannot be
+// allocated
+bool chained_resize(ChainedHashMap *map, size_t new_capacity) {
+    if (!map || new_capacity == 0) return false;
+#ifdef HASHMAP_STATS
+    double rebuild_start = now_ms();  // Counted as resize time
+#endif
+    ChainedNode **fresh = calloc(new_capacity, sizeof(ChainedNode*));
+    if (!fresh) return false;
+    
+    size_t old_capacity = map->capacity;
+    map->capacity = new_capacity;
+    ChainedMigration m = {map, map->buckets, fresh};
+    int threads = parallel_threads(map->resize_threads, map->size);
+#ifdef PARALLEL_ATOMICS
+    if (threads > 1) {
+        parallel_for(threads, old_capacity, chained_migrate_parallel, &m);
+    } else {
+        chained_migrate_serial(&m, 0, old_capacity);
+    }
+#else
+    (void)threads;
+    chained_migrate_serial(&m, 0, old_capacity);
+#endif
+    free(map->buckets);
+    map->buckets = fresh;
+#ifdef HASHMAP_TTL
+    if (map->sweep_cursor >= new_capacity) map->sweep_cursor = 0;
+#endif
+#ifdef HASHMAP_STATS
+    map->stats.resizes++;
+    map->stats.resize_ms += now_ms() - rebuild_start;
+#endif
+    return true;
+}
+
 // Return number of stored elements
 size_t chained_size(ChainedHashMap *map) {
     return map ? map->size : 0;
@@ -150,6 +605,33 @@ size_t chained_memory_usage(ChainedHashMap *map) {
     return mem;
 }
 
+// Build a read-only minimal perfect hash copy of the current contents
+// The map itself is left untouched and may keep changing
+FrozenMap* chained_freeze(ChainedHashMap *map) {
+    if (!map) return NULL;
+    
+    size_t n = map->size;
+    int *keys = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *values = malloc((n > 0 ? n : 1) * sizeof(int));
+    FrozenMap *frozen = NULL;
+    if (keys && values) {
+        // Walk every chain
+        size_t k = 0;
+        for (size_t i = 0; i < map->capacity; i++) {
+            for (ChainedNode *node = map->buckets[i]; node; node = node->next) {
+                if (TTL_EXPIRED(map, node)) continue;  // Not part of the copy
+                keys[k] = node->key;
+                values[k] = node->value;
+                k++;
+            }
+        }
+        frozen = frozen_build(keys, values, k, prng_next(&map->rng));
+    }
+    free(keys);
+    free(values);
+    return frozen;
+}
+
 // Return the length of the longest chain in the hash map
 int chained_max_chain_length(ChainedHashMap *map) {
     if (!map) return 0;
@@ -167,4 +649,98 @@ int chained_max_chain_length(ChainedHashMap *map) {
         if (len > max_len) max_len = len;  // Update max
     }
     return max_len; // Return longest chain length
-}
\ No newline at end of file
+}
+
+// Return number of flood-triggered reseeds
+int chained_reseed_count(ChainedHashMap *map) {
+    return map ? map->reseed_count : 0;
+}
+
+// Fill hist[k] with the number of buckets whose chain has k nodes
+// Chains of bins - 1 or more nodes are counted in the last bin
+// Returns the length of the longest chain
+size_t chained_chain_histogram(ChainedHashMap *map, size_t *hist, size_t bins) {
+    if (!map || !hist || bins == 0) return 0;
+    
+    for (size_t k = 0; k < bins; k++) hist[k] = 0;  // Clear bins
+    
+    size_t max_len = 0;
+    // One pass over every bucket
+    for (size_t i = 0; i < map->capacity; i++) {
+        size_t len = 0;
+        for (ChainedNode *node = map->buckets[i]; node; node = node->next) {
+            len++;
+        }
+        hist[len < bins ? len : bins - 1]++;  // Clamp into last bin
+        if (len > max_len) max_len = len;
+    }
+    return max_len;
+}
+
+// Copy operational counters into out
+// Returns false (and zeroes out) when built without HASHMAP_STATS
+bool chained_stats(ChainedHashMap *map, ChainedStats *out) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+#ifdef HASHMAP_STATS
+    if (!map) return false;
+    *out = map->stats;
+    return true;
+#else
+    (void)map;
+    return false;
+#endif
+}
+// Insert or update a pair that expires ttl ticks after the current map time
+// A ttl of 0 never expires. Returns false when built without HASHMAP_TTL
+bool chained_put_ttl(ChainedHashMap *map, int key, int value, uint64_t ttl) {
+#ifdef HASHMAP_TTL
+    if (!map) return false;
+    size_t idx = hash(key, map->seed, map->capacity);
+    return chained_put_hashed(map, key, value, idx, ttl_deadline(map->now, ttl));
+#else
+    (void)map; (void)key; (void)value; (void)ttl;
+    return false;
+#endif
+}
+
+// Set the map clock; nodes whose deadline is at or before now are expired
+void chained_set_time(ChainedHashMap *map, uint64_t now) {
+#ifdef HASHMAP_TTL
+    if (map) map->now = now;
+#else
+    (void)map; (void)now;
+#endif
+}
+
+// Free expired nodes in the next max_buckets buckets, resuming where the
+// previous call stopped, so the cost per call is bounded
+// Returns the number of nodes freed
+size_t chained_expire_step(ChainedHashMap *map, size_t max_buckets) {
+#ifdef HASHMAP_TTL
+    if (!map) return 0;
+    if (max_buckets > map->capacity) max_buckets = map->capacity;
+    
+    size_t freed = 0;
+    for (size_t n = 0; n < max_buckets; n++) {
+        size_t idx = map->sweep_cursor;
+        ChainedNode *prev = NULL;
+        ChainedNode *node = map->buckets[idx];
+        while (node) {
+            ChainedNode *next = node->next;
+            if (TTL_EXPIRED(map, node)) {
+                chained_unlink(map, idx, prev, node);
+                freed++;
+            } else {
+                prev = node;
+            }
+            node = next;
+        }
+        map->sweep_cursor = idx + 1 == map->capacity ? 0 : idx + 1;
+    }
+    return freed;
+#else
+    (void)map; (void)max_buckets;
+    return 0;
+#endif
+}
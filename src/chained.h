@@ -10,28 +10,88 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include "hashmap_stats.h"
+#include "hashmap_ttl.h"
+#include "prng.h"
+#include "frozen.h"
+
+// Default chain length (at load 1) that is treated as hash flooding
+// Random keys essentially never reach it, colliding keys do quickly
+#define CHAINED_FLOOD_CHAIN 32
+
+// Lookups kept in flight by chained_get_interleaved
+#define CHAINED_AMAC_LANES 12
 
 // Node structure for linked list in each bucket
 typedef struct ChainedNode {
     int key;                    // Key stored in this node
     int value;                  // Value associated with key
     struct ChainedNode *next;   // Pointer to next node in chain
+#ifdef HASHMAP_TTL
+    uint64_t expires;           // Deadline on the map clock, TTL_NEVER if none
+#endif
 } ChainedNode; // Linked list node
 
+// Operational counters, filled only when built with HASHMAP_STATS
+typedef struct {
+    size_t probes;  // Chain nodes visited by put/get/delete
+    size_t hits;    // Successful lookups
+    size_t misses;  // Failed lookups
+    size_t resizes; // Bucket array rebuilds (chained_resize and flood reseeds)
+    double resize_ms; // Wall time spent in them
+} ChainedStats;
+
+// Creation options for chained_create_with
+// A zeroed struct gives the same map as chained_create
+typedef struct {
+    uint64_t seed;     // PRNG seed for hash seeds, 0 = random per map
+    size_t max_chain;  // Flood threshold at load 1, 0 = CHAINED_FLOOD_CHAIN, SIZE_MAX = off
+    int resize_threads; // Threads relinking nodes in chained_resize, 0 = 1
+} ChainedOptions;
+
 // Main hash map structure
 typedef struct {
     ChainedNode **buckets;  // Array of pointers to linked list heads
     size_t capacity;        // Number of buckets
     size_t size;            // Number of key-value pairs stored
+    unsigned int seed;      // Seed mixed into the hash function
+    size_t max_chain;       // Chain length that triggers a reseed
+    size_t reseed_guard;    // No further reseed until size passes this
+    int reseed_count;       // Number of flood-triggered reseeds
+    int resize_threads;     // Threads used to relink nodes on resize
+    Prng rng;               // Per-map generator for hash seeds
+#ifdef HASHMAP_STATS
+    ChainedStats stats;     // Operational counters
+#endif
+#ifdef HASHMAP_TTL
+    uint64_t now;           // Map clock that deadlines are compared against
+    size_t sweep_cursor;    // Next bucket for chained_expire_step
+#endif
 } ChainedHashMap; // Main hash map structure
 
 ChainedHashMap* chained_create(size_t capacity); // Create a new chained hash map
+ChainedHashMap* chained_create_with(size_t capacity, const ChainedOptions *opts); // Create with options (NULL for defaults)
 void chained_destroy(ChainedHashMap *map); // Destroy the hash map and free memory
+void chained_clear(ChainedHashMap *map); // Remove all entries, keeping the buckets for reuse
 bool chained_put(ChainedHashMap *map, int key, int value); // Insert or update a key-value pair
 bool chained_get(ChainedHashMap *map, int key, int *value); // Retrieve value for key. Returns true if found
+int* chained_find_or_insert(ChainedHashMap *map, int key, bool *inserted); // Value slot of key, inserting 0 if absent (inserted may be NULL). Valid until the next mutation, NULL on failure
+bool chained_add(ChainedHashMap *map, int key, int delta); // Add delta to key's value, starting from 0 if absent
+size_t chained_put_batch(ChainedHashMap *map, const int *keys, const int *values, size_t n); // Insert n pairs, hashing keys in vector batches. Returns pairs stored
+size_t chained_get_batch(ChainedHashMap *map, const int *keys, int *values, bool *found, size_t n); // Look up n keys (values, found may be NULL). Returns keys found
+size_t chained_get_interleaved(ChainedHashMap *map, const int *keys, int *values, bool *found, size_t n); // Same as chained_get_batch, overlapping CHAINED_AMAC_LANES chain walks
 bool chained_delete(ChainedHashMap *map, int key); // Delete a key value pair
+bool chained_resize(ChainedHashMap *map, size_t new_capacity); // Relink every node onto new_capacity buckets
 size_t chained_size(ChainedHashMap *map); // Get number of stored elements
 size_t chained_memory_usage(ChainedHashMap *map); // Get total memory usage in bytes
+FrozenMap* chained_freeze(ChainedHashMap *map); // Build a read-only perfect hash copy (map is unchanged). NULL on failure
 int chained_max_chain_length(ChainedHashMap *map); // Get length of longest chain
+int chained_reseed_count(ChainedHashMap *map); // Get number of flood-triggered reseeds
+size_t chained_chain_histogram(ChainedHashMap *map, size_t *hist, size_t bins); // Count buckets by chain length. Returns longest chain
+bool chained_stats(ChainedHashMap *map, ChainedStats *out); // Copy counters. Returns false if stats are compiled out
+bool chained_put_ttl(ChainedHashMap *map, int key, int value, uint64_t ttl); // Insert or update a pair that expires ttl ticks from now (0 = never). False if TTL is compiled out
+void chained_set_time(ChainedHashMap *map, uint64_t now); // Advance the map clock used for expiry
+size_t chained_expire_step(ChainedHashMap *map, size_t max_buckets); // Reclaim expired nodes from at most max_buckets buckets. Returns nodes freed
 
 #endif
\ No newline at end of file
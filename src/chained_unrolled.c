@@ -0,0 +1,225 @@
+/*
+ * Unrolled Chained Hash Map Implementation
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * Separate chaining where a chain is a list of 64-byte blocks of up to
+ * UNROLLED_BLOCK_PAIRS keys instead of one node per key (an unrolled
+ * linked list, Shao, Reppy & Appel, 1994). Keys of a block are compared
+ * from one cache line, so a chain of up to seven keys costs a single
+ * dependent miss after the bucket, and there is one malloc per seven
+ * inserts. Only the head block is ever partly full: inserts fill it and
+ * deletes move its last pair into the hole, so the chain length stored
+ * in the bucket is all the bookkeeping a lookup needs.
+ */
+
+#define _POSIX_C_SOURCE 200112L // posix_memalign
+
+#include "chained_unrolled.h"
+#include "prng.h"
+#include <stdlib.h>
+
+// Block alignment: one block per cache line
+#define BLOCK_ALIGN 64
+
+/* Takes a key and capacity, returns bucket index
+* Code adapted from Appleby, A. (2011). MurmurHash3 fmix32() finalizer.
+* Retrieved from https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp.
+* The bit-mixing sequence and associated constants in the hash_with_seed function
+* were adapted from the fmix32() finalizer of MurmurHash3.
+*/
+static size_t hash(int key, unsigned int seed, size_t capacity) {
+    unsigned int k = (unsigned int)key;  // Convert to unsigned for bitwise ops
+    k ^= seed;           // Mix in the per-map seed
+    k ^= (k >> 16);      // Mix high bits into low bits
+    k *= 0x85ebca6b;     // Multiply by magic constant
+    k ^= (k >> 13);      // More bit mixing
+    k *= 0xc2b2ae35;     // Another magic constant
+    k ^= (k >> 16);      // Final mix
+    return k % capacity; // Reduce to valid bucket index
+}
+
+// Pairs used in the head block of a chain of count keys
+static size_t head_fill(size_t count) {
+    return count == 0 ? 0 : (count - 1) % UNROLLED_BLOCK_PAIRS + 1;
+}
+
+// Allocate one cache-line aligned block (contents uninitialized)
+static UnrolledBlock* alloc_block(void) {
+    void *block = NULL;
+    if (posix_memalign(&block, BLOCK_ALIGN, sizeof(UnrolledBlock)) != 0) {
+        return NULL;
+    }
+    return block;
+}
+
+// Free every block of a chain
+static void free_chain(UnrolledBlock *block) {
+    while (block) {
+        UnrolledBlock *next = block->next;  // Save next before freeing
+        free(block);
+        block = next;
+    }
+}
+
+// Create a new unrolled chained hash map with specified capacity
+ChainedUnrolledMap* chained_unrolled_create(size_t capacity) {
+    ChainedUnrolledMap *map = malloc(sizeof(ChainedUnrolledMap));
+    if (!map) return NULL;
+    
+    if (capacity == 0) capacity = 1;
+    map->buckets = calloc(capacity, sizeof(UnrolledBucket));
+    if (!map->buckets) {
+        free(map);
+        return NULL;
+    }
+    
+    map->capacity = capacity;
+    map->size = 0;
+    map->blocks = 0;
+    Prng rng;
+    prng_seed(&rng, prng_default_seed(map));
+    map->seed = (unsigned int)prng_next(&rng);
+    return map;
+}
+
+// Free all memory used by the hash map
+void chained_unrolled_destroy(ChainedUnrolledMap *map) {
+    if (!map) return;
+    for (size_t i = 0; i < map->capacity; i++) {
+        free_chain(map->buckets[i].head);
+    }
+    free(map->buckets);
+    free(map);
+}
+
+// Remove every entry but keep the bucket array for reuse
+void chained_unrolled_clear(ChainedUnrolledMap *map) {
+    if (!map) return;
+    // Only walk buckets while blocks remain
+    for (size_t i = 0; i < map->capacity && map->blocks > 0; i++) {
+        UnrolledBucket *b = &map->buckets[i];
+        for (UnrolledBlock *block = b->head; block; block = block->next) {
+            map->blocks--;
+        }
+        free_chain(b->head);
+        b->head = NULL;
+        b->count = 0;
+    }
+    map->size = 0;
+    map->blocks = 0;
+}
+
+// Locate key in a chain, one block (cache line) at a time
+// Returns true and sets *block_out and *slot_out if found
+static bool find_pair(UnrolledBucket *b, int key, UnrolledBlock **block_out,
+                      size_t *slot_out) {
+    size_t fill = head_fill(b->count);  // Later blocks are full
+    for (UnrolledBlock *block = b->head; block; block = block->next) {
+        for (size_t j = 0; j < fill; j++) {
+            if (block->keys[j] == key) {
+                *block_out = block;
+                *slot_out = j;
+                return true;
+            }
+        }
+        fill = UNROLLED_BLOCK_PAIRS;
+    }
+    return false;
+}
+
+// Insert or update a key value pair
+bool chained_unrolled_put(ChainedUnrolledMap *map, int key, int value) {
+    if (!map) return false;
+    
+    UnrolledBucket *b = &map->buckets[hash(key, map->seed, map->capacity)];
+    UnrolledBlock *block;
+    size_t slot;
+    if (find_pair(b, key, &block, &slot)) {
+        block->values[slot] = value;  // Update existing value
+        return true;
+    }
+    
+    // New key goes into the head block, or a new head when it is full
+    slot = head_fill(b->count);
+    if (!b->head || slot == UNROLLED_BLOCK_PAIRS) {
+        block = alloc_block();
+        if (!block) return false;  // Allocation failed
+        block->next = b->head;
+        b->head = block;
+        map->blocks++;
+        slot = 0;
+    }
+    b->head->keys[slot] = key;
+    b->head->values[slot] = value;
+    b->count++;
+    map->size++;
+    return true;
+}
+
+// Retrieve value for a key
+bool chained_unrolled_get(ChainedUnrolledMap *map, int key, int *value) {
+    if (!map) return false;
+    
+    UnrolledBucket *b = &map->buckets[hash(key, map->seed, map->capacity)];
+    UnrolledBlock *block;
+    size_t slot;
+    if (!find_pair(b, key, &block, &slot)) return false;  // Not found
+    if (value) *value = block->values[slot];
+    return true;
+}
+
+// Delete a key from the map
+// The head block's last pair fills the hole, so only the head shrinks
+bool chained_unrolled_delete(ChainedUnrolledMap *map, int key) {
+    if (!map) return false;
+    
+    UnrolledBucket *b = &map->buckets[hash(key, map->seed, map->capacity)];
+    UnrolledBlock *block;
+    size_t slot;
+    if (!find_pair(b, key, &block, &slot)) return false;  // Key not found
+    
+    UnrolledBlock *head = b->head;
+    size_t last = head_fill(b->count) - 1;
+    block->keys[slot] = head->keys[last];
+    block->values[slot] = head->values[last];
+    b->count--;
+    map->size--;
+    if (last == 0) {
+        // Head block is empty: unlink and free it
+        b->head = head->next;
+        free(head);
+        map->blocks--;
+    }
+    return true;
+}
+
+// Return number of stored elements
+size_t chained_unrolled_size(ChainedUnrolledMap *map) {
+    return map ? map->size : 0;
+}
+
+// Return number of blocks allocated over all chains
+size_t chained_unrolled_block_count(ChainedUnrolledMap *map) {
+    return map ? map->blocks : 0;
+}
+
+// Calculate total memory usage in bytes
+size_t chained_unrolled_memory_usage(ChainedUnrolledMap *map) {
+    if (!map) return 0;
+    size_t mem = sizeof(ChainedUnrolledMap);              // Main struct
+    mem += map->capacity * sizeof(UnrolledBucket);        // Bucket array
+    mem += map->blocks * sizeof(UnrolledBlock);           // All blocks
+    return mem;
+}
+
+// Return the length (in keys) of the longest chain
+int chained_unrolled_max_chain_length(ChainedUnrolledMap *map) {
+    if (!map) return 0;
+    size_t max_len = 0;
+    for (size_t i = 0; i < map->capacity; i++) {
+        if (map->buckets[i].count > max_len) max_len = map->buckets[i].count;
+    }
+    return (int)max_len;
+}
@@ -0,0 +1,53 @@
+/*
+ * Unrolled Chained Hash Map Header
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ */
+
+#ifndef CHAINED_UNROLLED_H // Include guard
+#define CHAINED_UNROLLED_H // Prevent multiple inclusions
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Pairs per block: 7 keys + 7 values + next pointer fill one 64-byte line
+#define UNROLLED_BLOCK_PAIRS 7
+
+// Cache-line block of a chain, allocated 64-byte aligned
+typedef struct UnrolledBlock {
+    int keys[UNROLLED_BLOCK_PAIRS];    // Keys stored in this block
+    int values[UNROLLED_BLOCK_PAIRS];  // Value of each key
+    struct UnrolledBlock *next;        // Next (always full) block in chain
+} UnrolledBlock;
+
+// Bucket: chain head and length
+// Only the head block may be partly full, so the length says how many
+// of its slots are used and no per-block count is needed
+typedef struct {
+    UnrolledBlock *head;  // First block of the chain, NULL if empty
+    size_t count;         // Keys in the whole chain
+} UnrolledBucket;
+
+// Main hash map structure
+typedef struct {
+    UnrolledBucket *buckets;  // Array of chains
+    size_t capacity;          // Number of buckets
+    size_t size;              // Number of key-value pairs stored
+    size_t blocks;            // Blocks allocated over all chains
+    unsigned int seed;        // Seed mixed into the hash function
+} ChainedUnrolledMap;
+
+ChainedUnrolledMap* chained_unrolled_create(size_t capacity); // Create a new unrolled chained hash map
+void chained_unrolled_destroy(ChainedUnrolledMap *map); // Destroy the hash map and free memory
+void chained_unrolled_clear(ChainedUnrolledMap *map); // Remove all entries, keeping the buckets for reuse
+bool chained_unrolled_put(ChainedUnrolledMap *map, int key, int value); // Insert or update a key value pair
+bool chained_unrolled_get(ChainedUnrolledMap *map, int key, int *value); // Retrieve value for key. Returns true if found
+bool chained_unrolled_delete(ChainedUnrolledMap *map, int key); // Delete a key value pair
+size_t chained_unrolled_size(ChainedUnrolledMap *map); // Get number of stored elements
+size_t chained_unrolled_block_count(ChainedUnrolledMap *map); // Get number of blocks allocated
+size_t chained_unrolled_memory_usage(ChainedUnrolledMap *map); // Get total memory usage in bytes
+int chained_unrolled_max_chain_length(ChainedUnrolledMap *map); // Get length (in keys) of longest chain
+
+#endif
@@ -7,9 +7,23 @@
  * Cuckoo Hash Map Implementation is based on: Pagh, R., & Rodler, F. F. (2004). Cuckoo hashing. 
  * Journal of Algorithms, 51(2), 122-144.
  * 
+ * The d-ary mode (3 or 4 sub-tables) follows: Fotakis, D., Pagh, R., Sanders, P., &
+ * Spirakis, P. (2005). Space efficient hash tables with worst case constant access time.
+ * Theory of Computing Systems, 38(2), 229-248. Insertion uses the random-walk
+ * eviction of Frieze, A., Melsted, P., & Mitzenmacher, M. (2011). An analysis of
+ * random-walk cuckoo hashing. SIAM Journal on Computing, 40(2), 291-308.
+ * 
+ * Built with HASHMAP_TTL, every entry carries a deadline that moves with
+ * it through kick chains, the stash and rebuilds. An expired entry is
+ * cleared by the first lookup that reaches it, and cuckoo_expire_step
+ * sweeps a few slots per call for entries nobody asks for again.
  */
 
+#define _POSIX_C_SOURCE 200112L // clock_gettime
+
 #include "cuckoo.h"
+#include "hash_simd.h"
+#include "parallel.h"
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -17,7 +31,14 @@
 // Maximum displacement attempts before triggering rehash
 #define MAX_DISPLACEMENTS 500
 
-/* Hash function with configurable seed for generating independent h1 and h2
+// Seed pairs tried by one rebuild before it gives up
+#define MAX_REBUILD_ATTEMPTS 8
+
+// Default growth threshold per number of ways (see cuckoo_put)
+// 2 ways stays under the ~50% bound, 3 and 4 ways under ~91.8% and ~97.7%
+static const double default_max_load[CUCKOO_MAX_WAYS + 1] = {0, 0, 0.45, 0.88, 0.95};
+
+/* Hash function with configurable seed for generating independent h1..hd
 * Code adapted from Appleby, A. (2011). MurmurHash3 fmix32() finalizer. 
 * Retrieved from https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp.
 * The bit-mixing sequence and associated constants in the hash_with_seed function 
@@ -34,42 +55,74 @@ static size_t hash_with_seed(int key, unsigned int seed, size_t capacity) {
     return k % capacity;
 }
 
-// First hash function - uses seed1
-static size_t h1(CuckooHashMap *map, int key) {
-    return hash_with_seed(key, map->seed1, map->capacity);
-}
-
-// Second hash function
-// Uses seed2 to ensure independence from h1
-// Different seed produces different hash outputs
-static size_t h2(CuckooHashMap *map, int key) {
-    return hash_with_seed(key, map->seed2, map->capacity);
+// Hash function for table t - uses seeds[t]
+// Different seed produces different hash outputs, so each table
+// gets an independent position for the same key
+static size_t slot_index(CuckooHashMap *map, int t, int key) {
+    return hash_with_seed(key, map->seeds[t], map->capacity);
 }
 
 // Initialize hash function seeds with random values
+// Drawn from the map's own generator, not the global rand()
 static void init_seeds(CuckooHashMap *map) {
-    map->seed1 = (unsigned int)rand();
-    map->seed2 = (unsigned int)rand();
-    // Ensure seeds are different for independent hash functions
-    while (map->seed2 == map->seed1) {
-        map->seed2 = (unsigned int)rand();
+    for (int t = 0; t < map->ways; t++) {
+        bool unique;
+        // Ensure seeds are different for independent hash functions
+        do {
+            map->seeds[t] = (unsigned int)prng_next(&map->rng);
+            unique = true;
+            for (int u = 0; u < t; u++) {
+                if (map->seeds[u] == map->seeds[t]) unique = false;
+            }
+        } while (!unique);
     }
 }
 
+// Allocate one zeroed table of capacity slots using the map's allocation mode
+static CuckooEntry* alloc_table(CuckooHashMap *map, size_t capacity) {
+    return table_alloc(capacity * sizeof(CuckooEntry), &map->alloc);
+}
+
+// Release a table allocated by alloc_table (NULL is ignored)
+static void free_table(CuckooHashMap *map, CuckooEntry *table, size_t capacity) {
+    table_free(table, capacity * sizeof(CuckooEntry), &map->alloc);
+}
+
 // Create a new cuckoo hash map
 CuckooHashMap* cuckoo_create(size_t capacity) {
+    return cuckoo_create_with(capacity, NULL);
+}
+
+// Create a new cuckoo hash map with creation options
+CuckooHashMap* cuckoo_create_with(size_t capacity, const CuckooOptions *opts) {
     // Allocate main structure
     CuckooHashMap *map = malloc(sizeof(CuckooHashMap));
     if (!map) return NULL;
     
-    // Allocate both tables
-    map->table1 = calloc(capacity, sizeof(CuckooEntry));
-    map->table2 = calloc(capacity, sizeof(CuckooEntry));
+    // Tables are allocated (and later resized) with these options
+    memset(&map->alloc, 0, sizeof(map->alloc));
+    if (opts) map->alloc = opts->alloc;
+    
+    // Number of sub-tables (hash functions), 2 unless asked otherwise
+    int ways = (opts && opts->ways) ? opts->ways : 2;
+    if (ways < 2 || ways > CUCKOO_MAX_WAYS) {
+        free(map);
+        return NULL;  // Unsupported configuration
+    }
+    map->ways = ways;
+    
+    // Allocate every table
+    bool ok = true;
+    for (int t = 0; t < CUCKOO_MAX_WAYS; t++) {
+        map->tables[t] = (t < ways) ? alloc_table(map, capacity) : NULL;
+        if (t < ways && !map->tables[t]) ok = false;
+    }
     
     // Check for allocation failure
-    if (!map->table1 || !map->table2) {
-        free(map->table1);
-        free(map->table2);
+    if (!ok) {
+        for (int t = 0; t < ways; t++) {
+            free_table(map, map->tables[t], capacity);
+        }
         free(map);
         return NULL;
     }
@@ -78,8 +131,50 @@ CuckooHashMap* cuckoo_create(size_t capacity) {
     map->size = 0;               // Initially empty
     map->rehash_count = 0;       // No rehashes yet
     
-    srand((unsigned int)time(NULL));  // Seed random number generator
-    init_seeds(map);                   // Generate hash function seeds
+    // Small stash absorbs rare eviction cycles without a full rehash
+    int stash = (opts && opts->stash_size) ? opts->stash_size : CUCKOO_STASH_SIZE;
+    if (stash < 0) stash = 0;
+    if (stash > CUCKOO_MAX_STASH) stash = CUCKOO_MAX_STASH;
+    map->stash_capacity = stash;
+    map->stash_count = 0;
+    map->max_load = (opts && opts->max_load > 0) ? opts->max_load
+                                                 : default_max_load[ways];
+    map->resize_threads = opts ? opts->resize_threads : 0;
+    
+    // Cache mode: fixed tables with an access word per slot. A failed
+    // eviction chain drops its homeless key, so the stash is not used
+    map->cache = opts ? opts->cache : CACHE_NONE;
+    map->clock_hand = 0;
+    map->tick = 0;
+    map->evictions = 0;
+    for (int t = 0; t < CUCKOO_MAX_WAYS; t++) {
+        map->access[t] = NULL;
+        if (map->cache != CACHE_NONE && t < ways) {
+            map->access[t] = calloc(capacity, sizeof(uint32_t));
+            if (!map->access[t]) ok = false;
+        }
+    }
+    if (!ok) {
+        for (int t = 0; t < ways; t++) {
+            free_table(map, map->tables[t], capacity);
+            free(map->access[t]);
+        }
+        free(map);
+        return NULL;
+    }
+    if (map->cache != CACHE_NONE) map->stash_capacity = 0;
+#ifdef HASHMAP_STATS
+    memset(&map->stats, 0, sizeof(map->stats));  // Counters start at zero
+#endif
+#ifdef HASHMAP_TTL
+    map->now = 0;
+    map->sweep_cursor = 0;
+#endif
+    
+    // Per-map generator: reproducible when the caller passes a seed
+    uint64_t seed = (opts && opts->seed) ? opts->seed : prng_default_seed(map);
+    prng_seed(&map->rng, seed);
+    init_seeds(map);  // Generate hash function seeds
     
     return map;
 }
@@ -87,288 +182,745 @@ CuckooHashMap* cuckoo_create(size_t capacity) {
 // Free all memory
 void cuckoo_destroy(CuckooHashMap *map) {
     if (!map) return;
-    free(map->table1);
-    free(map->table2);
+    for (int t = 0; t < map->ways; t++) {
+        free_table(map, map->tables[t], map->capacity);
+        free(map->access[t]);  // Cache mode access words (NULL otherwise)
+    }
     free(map);
 }
 
+// Remove every entry but keep the tables and seeds for reuse
+void cuckoo_clear(CuckooHashMap *map) {
+    if (!map) return;
+    size_t bytes = map->capacity * sizeof(CuckooEntry);
+    for (int t = 0; t < map->ways; t++) {
+        map->tables[t] = table_reset(map->tables[t], bytes, &map->alloc);
+        if (map->access[t]) {
+            memset(map->access[t], 0, map->capacity * sizeof(uint32_t));
+        }
+    }
+    map->clock_hand = 0;
+    map->stash_count = 0;
+    map->size = 0;
+#ifdef HASHMAP_TTL
+    map->sweep_cursor = 0;
+#endif
+}
+
+// Return the stash index holding key, or -1
+static int stash_find(CuckooHashMap *map, int key) {
+    for (int i = 0; i < map->stash_count; i++) {
+        if (map->stash[i].key == key) return i;
+    }
+    return -1;
+}
+
+// Remove stash entry i, keeping the stash packed
+static void stash_remove(CuckooHashMap *map, int i) {
+    map->stash[i] = map->stash[--map->stash_count];
+    map->size--;
+}
+
+// Compute the candidate slot of key in every table
+// The hashes are independent, so the loads that follow can overlap
+static void candidate_slots(CuckooHashMap *map, int key, size_t *idx) {
+    for (int t = 0; t < map->ways; t++) {
+        idx[t] = slot_index(map, t, key);
+#ifdef __GNUC__
+        __builtin_prefetch(&map->tables[t][idx[t]]);
+#endif
+    }
+}
+
+// Candidate slots of a batch of keys, one vectorized pass per table
+static void batch_slots(CuckooHashMap *map, const int *keys, size_t n,
+                        size_t idx[][CUCKOO_MAX_WAYS]) {
+    unsigned int h[HASH_BATCH];
+    for (int t = 0; t < map->ways; t++) {
+        hash_batch(keys, map->seeds[t], h, n);
+        for (size_t i = 0; i < n; i++) {
+            idx[i][t] = h[i] % map->capacity;
+        }
+    }
+}
+
+// Pick the table to evict from, never the one the key was just evicted from
+// With 2 ways this is plain alternation, with more it is a random walk
+static int victim_table(CuckooHashMap *map, int from) {
+    if (from < 0) return (int)(prng_next(&map->rng) % (uint64_t)map->ways);
+    int t = (int)(prng_next(&map->rng) % (uint64_t)(map->ways - 1));
+    return t >= from ? t + 1 : t;
+}
+
+// Keys a cache mode map holds before an insert evicts (at least 1)
+static size_t cache_limit(CuckooHashMap *map) {
+    size_t limit = (size_t)(map->max_load * map->ways * map->capacity);
+    return limit > 0 ? limit : 1;
+}
+
+// Evict one key chosen by the cache policy
+// Slots are numbered across all tables: slot i is table i / capacity
+static void cache_evict(CuckooHashMap *map) {
+    size_t cap = map->capacity;
+    size_t total = (size_t)map->ways * cap;
+    size_t victim = total;
+    
+    if (map->cache == CACHE_CLOCK) {
+        // Sweep the hand, clearing reference bits as a second chance
+        while (victim == total) {
+            size_t i = map->clock_hand;
+            map->clock_hand = (i + 1) % total;
+            if (!map->tables[i / cap][i % cap].occupied) continue;
+            uint32_t *ref = &map->access[i / cap][i % cap];
+            if (*ref == 0) {
+                victim = i;
+            } else {
+                *ref = 0;
+            }
+        }
+    } else {
+        // Least recently used of a few random occupied slots
+        uint32_t oldest = 0;  // Access word of the current victim
+        for (int s = 0; s < CACHE_LRU_SAMPLES; s++) {
+            size_t i = (size_t)(prng_next(&map->rng) % total);
+            while (!map->tables[i / cap][i % cap].occupied) {
+                i = (i + 1) % total;
+            }
+            uint32_t access = map->access[i / cap][i % cap];
+            if (victim == total ||
+                cache_colder(map->cache, map->tick, access, oldest)) {
+                victim = i;
+                oldest = access;
+            }
+        }
+    }
+    
+    map->tables[victim / cap][victim % cap].occupied = false;
+    map->size--;
+    map->evictions++;
+}
+
 // Forward declaration for mutual recursion with insert
 static bool cuckoo_rehash(CuckooHashMap *map);
 
+// Record the number of evictions performed by one insertion
+static void record_kick_chain(CuckooHashMap *map, size_t length) {
+#ifdef HASHMAP_STATS
+    if (length > 0) map->stats.kick_chains++;
+    STAT_MAX(map, max_kick_chain, length);
+#else
+    (void)map;
+    (void)length;
+#endif
+}
+
 // Internal insert function
+// slots holds the key's candidate slot in every table
+// expires is the entry's deadline (ignored without HASHMAP_TTL)
 // allow_rehash controls whether we can trigger rehash on cycle detection
 // Set to false during rehash to prevent infinite recursion
-static bool cuckoo_insert_internal(CuckooHashMap *map, int key, int value, 
-                                    bool allow_rehash) {
-    // First check if key already exists in either table
-    size_t idx1 = h1(map, key);
-    size_t idx2 = h2(map, key);
-    
-    // Check table1 for existing key
-    if (map->table1[idx1].occupied && map->table1[idx1].key == key) {
-        map->table1[idx1].value = value;  // Update value
-        return true;
+static bool cuckoo_insert_hashed(CuckooHashMap *map, int key, int value,
+                                 uint64_t expires, const size_t *slots,
+                                 bool allow_rehash) {
+    // First check if key already exists in any table
+    size_t idx[CUCKOO_MAX_WAYS];
+    memcpy(idx, slots, (size_t)map->ways * sizeof(size_t));
+    STAT_ADD(map, probes, map->ways);
+    
+    for (int t = 0; t < map->ways; t++) {
+        CuckooEntry *e = &map->tables[t][idx[t]];
+        if (e->occupied && e->key == key) {
+            e->value = value;  // Update value
+            TTL_SET(e, expires);
+            if (map->cache != CACHE_NONE) {
+                map->access[t][idx[t]] = cache_touch(map->cache, &map->tick);
+            }
+            return true;
+        }
     }
-    // Check table2 for existing key
-    if (map->table2[idx2].occupied && map->table2[idx2].key == key) {
-        map->table2[idx2].value = value;  // Update value
+    // Check the stash for existing key
+    int stashed = stash_find(map, key);
+    if (stashed >= 0) {
+        map->stash[stashed].value = value;  // Update value
+        TTL_SET(&map->stash[stashed], expires);
         return true;
     }
     
     // Key doesn't exist, need to insert
+    // A full cache makes room first instead of growing
+    uint32_t cur_access = 0;  // Access word travelling with cur_key
+    if (map->cache != CACHE_NONE) {
+        if (map->size >= cache_limit(map)) cache_evict(map);
+        cur_access = cache_admit(map->cache, &map->tick);
+    }
+    
     // Start displacement chain
-    int cur_key = key;
-    int cur_value = value;
-    int use_table1 = 1;  // Alternate between tables
+    // Whole entries are moved so a deadline travels with its key
+    CuckooEntry cur;
+    memset(&cur, 0, sizeof(cur));
+    cur.key = key;
+    cur.value = value;
+    cur.occupied = true;
+    TTL_SET(&cur, expires);
+    int from = -1;  // Table the current key was evicted from
     
     // Try up to MAX_DISPLACEMENTS before giving up
     for (int i = 0; i < MAX_DISPLACEMENTS; i++) {
-        if (use_table1) {
-            // Try to place in table1
-            size_t idx = h1(map, cur_key);
-            if (!map->table1[idx].occupied) {
+        if (i > 0) {
+            STAT_INC(map, displacements);  // Placing an evicted key
+            candidate_slots(map, cur.key, idx);
+        }
+        
+        // Any empty candidate slot ends the chain
+        for (int t = 0; t < map->ways; t++) {
+            if (t == from) continue;  // Just evicted from there
+            CuckooEntry *e = &map->tables[t][idx[t]];
+            if (!e->occupied) {
                 // Empty slot found 
                 // Success!
-                map->table1[idx].key = cur_key;
-                map->table1[idx].value = cur_value;
-                map->table1[idx].occupied = true;
+                *e = cur;
+                if (map->cache != CACHE_NONE) map->access[t][idx[t]] = cur_access;
                 map->size++;
+                record_kick_chain(map, (size_t)i);
                 return true;
             }
-            // Slot occupied
-            // Evict current resident
-            int evicted_key = map->table1[idx].key;
-            int evicted_value = map->table1[idx].value;
-            // Place our key here
-            map->table1[idx].key = cur_key;
-            map->table1[idx].value = cur_value;
-            // Now we need to relocate the evicted key
-            cur_key = evicted_key;
-            cur_value = evicted_value;
-            use_table1 = 0;  // Try table2 next for evicted key
-        } else {
-            // Try to place in table2
-            size_t idx = h2(map, cur_key);
-            if (!map->table2[idx].occupied) {
-                // Empty slot found
-                // Success!
-                map->table2[idx].key = cur_key;
-                map->table2[idx].value = cur_value;
-                map->table2[idx].occupied = true;
+        }
+        
+        // All candidates occupied
+        // Evict the resident of one of them
+        int t = victim_table(map, from);
+        CuckooEntry *e = &map->tables[t][idx[t]];
+        CuckooEntry evicted = *e;
+        // Place our key here
+        *e = cur;
+        if (map->cache != CACHE_NONE) {
+            uint32_t evicted_access = map->access[t][idx[t]];
+            map->access[t][idx[t]] = cur_access;
+            cur_access = evicted_access;
+        }
+        // Now we need to relocate the evicted key
+        cur = evicted;
+        from = t;  // Try its other tables next
+    }
+    
+    // Exceeded MAX_DISPLACEMENTS - likely a cycle
+    // Park the homeless key in the stash if there is room
+    record_kick_chain(map, MAX_DISPLACEMENTS);
+    if (map->cache != CACHE_NONE) {
+        // A cache may forget rather than grow, but the policy decides
+        // what: the homeless key takes the slot of its coldest candidate
+        // if that one is colder than itself, and the colder key is dropped
+        candidate_slots(map, cur.key, idx);
+        int coldest = -1;
+        uint32_t coldest_access = cur_access;
+        for (int t = 0; t < map->ways; t++) {
+            CuckooEntry *e = &map->tables[t][idx[t]];
+            if (!e->occupied) {
+                // Last eviction freed a candidate: no key is lost
+                *e = cur;
+                map->access[t][idx[t]] = cur_access;
                 map->size++;
                 return true;
             }
-            // Slot occupied
-            // Evict current resident
-            int evicted_key = map->table2[idx].key;
-            int evicted_value = map->table2[idx].value;
-            // Place our key here
-            map->table2[idx].key = cur_key;
-            map->table2[idx].value = cur_value;
-            // Now we need to relocate the evicted key
-            cur_key = evicted_key;
-            cur_value = evicted_value;
-            use_table1 = 1;  // Try table1 next for evicted key
+            uint32_t access = map->access[t][idx[t]];
+            if (cache_colder(map->cache, map->tick, access, coldest_access)) {
+                coldest = t;
+                coldest_access = access;
+            }
+        }
+        if (coldest >= 0) {
+            CuckooEntry *e = &map->tables[coldest][idx[coldest]];
+            CuckooEntry dropped = *e;
+            *e = cur;
+            map->access[coldest][idx[coldest]] = cur_access;
+            cur = dropped;
         }
+        map->evictions++;
+        return cur.key != key;
+    }
+    if (map->stash_count < map->stash_capacity) {
+        map->stash[map->stash_count++] = cur;
+        map->size++;
+        STAT_INC(map, stashed);
+        return true;
     }
     
-    // Exceeded MAX_DISPLACEMENTS - likely a cycle
-    // Need to rehash with new hash functions
+    // Stash full: need to rehash with new hash functions
     if (allow_rehash) {
-        // Save the displaced key for reinsertion after rehash
-        int displaced_key = cur_key;
-        int displaced_value = cur_value;
-        
+        // cur holds the displaced key for reinsertion after rehash
         if (!cuckoo_rehash(map)) {
             return false;  // Rehash failed
         }
         
         // Try inserting the displaced key with new hash functions
-        return cuckoo_insert_internal(map, displaced_key, displaced_value, true);
+        candidate_slots(map, cur.key, idx);
+        return cuckoo_insert_hashed(map, cur.key, cur.value, TTL_GET(&cur),
+                                    idx, true);
     }
     
     return false;  // Failed and can't rehash
 }
 
-// Rehash the tables with new hash functions
-// Reinserts all existing entries
-static bool cuckoo_rehash(CuckooHashMap *map) {
-    // Save old tables
-    CuckooEntry *old_table1 = map->table1;
-    CuckooEntry *old_table2 = map->table2;
+// Internal insert of a single key, hashing it first
+static bool cuckoo_insert_internal(CuckooHashMap *map, int key, int value, 
+                                    uint64_t expires, bool allow_rehash) {
+    size_t idx[CUCKOO_MAX_WAYS];
+    candidate_slots(map, key, idx);
+    return cuckoo_insert_hashed(map, key, value, expires, idx, allow_rehash);
+}
+
+// Reinsert n entries during a rebuild, hashing them as one batch
+static bool reinsert_batch(CuckooHashMap *map, const CuckooEntry *entries,
+                           size_t n) {
+    int keys[HASH_BATCH];
+    size_t idx[HASH_BATCH][CUCKOO_MAX_WAYS];
+    for (size_t i = 0; i < n; i++) keys[i] = entries[i].key;
+    batch_slots(map, keys, n, idx);
+    for (size_t i = 0; i < n; i++) {
+        if (!cuckoo_insert_hashed(map, entries[i].key, entries[i].value,
+                                  TTL_GET(&entries[i]), idx[i], false)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Shared state of the parallel phase of a rebuild
+typedef struct {
+    CuckooHashMap *map;        // Already switched to the new tables and seeds
+    CuckooEntry **old;         // Old tables, numbered as one flat range
+    size_t old_capacity;       // Slots per old table
+    CuckooEntry *overflow;     // Entries whose candidate slots were all taken
+    size_t overflow_count;     // Entries in overflow
+    size_t placed;             // Entries claimed straight into a table
+} CuckooMigration;
+
+#ifdef PARALLEL_ATOMICS
+// Move old slots [begin, end) into a free candidate slot, claimed by
+// switching occupied from false to true with compare-and-swap. Entries
+// whose candidates are all taken would need a kick chain, which cannot run
+// concurrently: they are staged in overflow for the serial phase
+static void cuckoo_migrate_parallel(void *ctx, size_t begin, size_t end) {
+    CuckooMigration *m = ctx;
+    CuckooHashMap *map = m->map;
+    size_t placed = 0;
+    for (size_t i = begin; i < end; i++) {
+        const CuckooEntry *e = &m->old[i / m->old_capacity][i % m->old_capacity];
+        if (!e->occupied || TTL_EXPIRED(map, e)) continue;
+        bool claimed = false;
+        for (int t = 0; t < map->ways && !claimed; t++) {
+            CuckooEntry *slot = &map->tables[t][slot_index(map, t, e->key)];
+            if (PARALLEL_CAS(&slot->occupied, false, true)) {
+                slot->key = e->key;
+                slot->value = e->value;
+                TTL_SET(slot, TTL_GET(e));
+                claimed = true;
+            }
+        }
+        if (claimed) {
+            placed++;
+        } else {
+            m->overflow[PARALLEL_FETCH_ADD(&m->overflow_count, 1)] = *e;
+        }
+    }
+    if (placed > 0) PARALLEL_FETCH_ADD(&m->placed, placed);
+}
+#endif
+
+#ifdef HASHMAP_STATS
+// Wall clock in milliseconds, for resize timing (clock() would add up
+// the CPU time of every migration thread)
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+#endif
+
+// Move every entry into fresh tables of new_capacity under new seeds
+// Shared by growth and by cycle-triggered rehashing so each key is
+// reinserted once per successful attempt. A failed attempt only costs
+// fresh seeds; the old tables are kept until the move succeeds
+// Large tables are first spread over resize_threads threads, which place
+// every key that has a free candidate slot; the rest are kicked in serially
+static bool cuckoo_rebuild(CuckooHashMap *map, size_t new_capacity) {
+#ifdef HASHMAP_STATS
+    double rebuild_start = now_ms();  // Counted as resize time
+#endif
+    // Save old tables and stash
+    CuckooEntry *old_tables[CUCKOO_MAX_WAYS];
+    memcpy(old_tables, map->tables, sizeof(old_tables));
     size_t old_capacity = map->capacity;
     size_t old_size = map->size;
+    CuckooEntry old_stash[CUCKOO_MAX_STASH];
+    int old_stash_count = map->stash_count;
+    memcpy(old_stash, map->stash, sizeof(old_stash));
     
-    // Allocate new tables
-    // Keep same capacity for simplicity
-    map->table1 = calloc(old_capacity, sizeof(CuckooEntry));
-    map->table2 = calloc(old_capacity, sizeof(CuckooEntry));
-    
-    if (!map->table1 || !map->table2) {
-        // Allocation failed
-        // Restore old tables
-        free(map->table1);
-        free(map->table2);
-        map->table1 = old_table1;
-        map->table2 = old_table2;
-        return false;
-    }
-    
-    // Generate new hash function seeds
-    init_seeds(map);
-    map->size = 0;          // Reset size for reinsertion
-    map->rehash_count++;    // Track rehash for analysis
+    // Staging for the parallel phase; without it the rebuild is serial
+    CuckooMigration m = {map, old_tables, old_capacity, NULL, 0, 0};
+    int threads = parallel_threads(map->resize_threads, old_size);
+#ifdef PARALLEL_ATOMICS
+    if (threads > 1) m.overflow = malloc(old_size * sizeof(CuckooEntry));
+#endif
     
-    // Reinsert all entries from old tables
-    for (size_t i = 0; i < old_capacity; i++) {
-        if (old_table1[i].occupied) {
-            // Don't allow nested rehash during rehash
-            if (!cuckoo_insert_internal(map, old_table1[i].key, 
-                                        old_table1[i].value, false)) {
-                // Rehash failed
-                // Restore old state
-                free(map->table1);
-                free(map->table2);
-                map->table1 = old_table1;
-                map->table2 = old_table2;
-                map->size = old_size;
-                return false;
+    for (int attempt = 0; attempt < MAX_REBUILD_ATTEMPTS; attempt++) {
+        // Fresh zeroed tables (mmap modes do not touch pages up front)
+        bool ok = true;
+        for (int t = 0; t < map->ways; t++) {
+            map->tables[t] = alloc_table(map, new_capacity);
+            if (!map->tables[t]) ok = false;
+        }
+        if (!ok) {
+            for (int t = 0; t < map->ways; t++) {
+                free_table(map, map->tables[t], new_capacity);
+            }
+            break;  // Out of memory, retrying will not help
+        }
+        
+        map->capacity = new_capacity;
+        map->size = 0;     // Reset size for reinsertion
+        map->stash_count = 0;
+        init_seeds(map);   // New hash functions
+        
+        // Reinsert all entries from old tables, HASH_BATCH keys at a time
+        // Nested rehash is not allowed, a failure just tries new seeds
+        // Expired entries are not carried over
+        bool success = true;
+        CuckooEntry batch[HASH_BATCH];
+        size_t pending = 0;
+#ifdef PARALLEL_ATOMICS
+        if (m.overflow) {
+            m.overflow_count = 0;
+            m.placed = 0;
+            parallel_for(threads, (size_t)map->ways * old_capacity,
+                         cuckoo_migrate_parallel, &m);
+            map->size = m.placed;
+            for (size_t i = 0; i < m.overflow_count && success; i++) {
+                batch[pending++] = m.overflow[i];
+                if (pending == HASH_BATCH) {
+                    success = reinsert_batch(map, batch, pending);
+                    pending = 0;
+                }
+            }
+        }
+#endif
+        for (int t = 0; t < map->ways && success && !m.overflow; t++) {
+            CuckooEntry *old = old_tables[t];
+            for (size_t i = 0; i < old_capacity && success; i++) {
+                if (!old[i].occupied || TTL_EXPIRED(map, &old[i])) continue;
+                batch[pending++] = old[i];
+                if (pending == HASH_BATCH) {
+                    success = reinsert_batch(map, batch, pending);
+                    pending = 0;
+                }
             }
         }
-        if (old_table2[i].occupied) {
-            if (!cuckoo_insert_internal(map, old_table2[i].key, 
-                                        old_table2[i].value, false)) {
-                // Rehash failed - restore old state
-                free(map->table1);
-                free(map->table2);
-                map->table1 = old_table1;
-                map->table2 = old_table2;
-                map->size = old_size;
-                return false;
+        // Stashed keys get another chance at a table slot
+        for (int i = 0; i < old_stash_count && success; i++) {
+            if (TTL_EXPIRED(map, &old_stash[i])) continue;
+            batch[pending++] = old_stash[i];
+            if (pending == HASH_BATCH) {
+                success = reinsert_batch(map, batch, pending);
+                pending = 0;
             }
         }
+        if (success && pending > 0) {
+            success = reinsert_batch(map, batch, pending);
+        }
+        
+        if (success) {
+            // Free old tables
+            for (int t = 0; t < map->ways; t++) {
+                free_table(map, old_tables[t], old_capacity);
+            }
+            free(m.overflow);
+#ifdef HASHMAP_STATS
+            map->stats.resize_ms += now_ms() - rebuild_start;
+#endif
+            return true;
+        }
+        
+        // Discard the partial tables and try again
+        for (int t = 0; t < map->ways; t++) {
+            free_table(map, map->tables[t], new_capacity);
+        }
     }
     
-    // Success
-    // Free old tables
-    free(old_table1);
-    free(old_table2);
-    return true;
+    // Restore old state
+    free(m.overflow);
+    memcpy(map->tables, old_tables, sizeof(old_tables));
+    map->capacity = old_capacity;
+    map->size = old_size;
+    memcpy(map->stash, old_stash, sizeof(old_stash));
+    map->stash_count = old_stash_count;
+    return false;
 }
 
-// Public insert function
-bool cuckoo_put(CuckooHashMap *map, int key, int value) {
-    if (!map) return false;
-    
+// Rehash the tables with new hash functions
+// Keeps the capacity when possible, otherwise grows so the caller's
+// displaced key is never dropped because of unlucky seeds
+static bool cuckoo_rehash(CuckooHashMap *map) {
+    map->rehash_count++;    // Track rehash for analysis
+    if (cuckoo_rebuild(map, map->capacity)) return true;
+    return cuckoo_rebuild(map, map->capacity * 2);
+}
+
+// Grow the tables when the load passes max_load
+static void grow_if_needed(CuckooHashMap *map) {
     /*
     * Check load factor and expand if too high
     * Code adapted from Kutzelnigg, R. (2006). Bipartite random graphs and cuckoo hashing.
     * Proceedings of the Fourth Colloquium on Mathematics and Computer Science, 400-406.
     * Retrieved from https://arxiv.org/abs/cs/0604034.
     */ 
-    double load = (double)map->size / (2.0 * map->capacity);
-    if (load > 0.45 && map->size > 0) {
-        // Need to expand tables
-        size_t new_capacity = map->capacity * 2;
-        CuckooEntry *old_table1 = map->table1;
-        CuckooEntry *old_table2 = map->table2;
-        size_t old_capacity = map->capacity;
-        
-        // Allocate larger tables
-        map->table1 = calloc(new_capacity, sizeof(CuckooEntry));
-        map->table2 = calloc(new_capacity, sizeof(CuckooEntry));
+    if (map->cache != CACHE_NONE) return;  // Cache mode evicts instead
+    double load = cuckoo_load_factor(map);
+    if (load > map->max_load && map->size > 0) {
+        // Expand tables; on failure keep going at the old capacity
+        if (cuckoo_rebuild(map, map->capacity * 2)) {
+            STAT_INC(map, resizes);
+        }
+    }
+}
+
+// Move every entry into tables of new_capacity slots each under new seeds
+// Fails in cache mode, if the tables cannot hold every key, or if no
+// seeds place them all; the map is unchanged then
+bool cuckoo_resize(CuckooHashMap *map, size_t new_capacity) {
+    if (!map || map->cache != CACHE_NONE || new_capacity == 0) return false;
+    if (new_capacity * (size_t)map->ways + (size_t)map->stash_capacity < map->size) {
+        return false;
+    }
+    if (!cuckoo_rebuild(map, new_capacity)) return false;
+    STAT_INC(map, resizes);
+    return true;
+}
+
+// Public insert function
+bool cuckoo_put(CuckooHashMap *map, int key, int value) {
+    if (!map) return false;
+    grow_if_needed(map);
+    
+    // Insert the key
+    // Return true if inserted, false if rehash needed and failed
+    return cuckoo_insert_internal(map, key, value, TTL_NEVER, true);
+}
+
+// Whether a rebuild changed the capacity or seeds since the snapshot
+// Refreshes the snapshot when it did
+static bool layout_moved(CuckooHashMap *map, size_t *capacity,
+                         unsigned int *seeds) {
+    if (map->capacity == *capacity &&
+        memcmp(seeds, map->seeds, sizeof(map->seeds)) == 0) {
+        return false;
+    }
+    *capacity = map->capacity;
+    memcpy(seeds, map->seeds, sizeof(map->seeds));
+    return true;
+}
+
+// Insert n pairs, hashing each group of HASH_BATCH keys in one pass
+// Returns the number of pairs stored
+size_t cuckoo_put_batch(CuckooHashMap *map, const int *keys,
+                        const int *values, size_t n) {
+    if (!map || !keys || !values) return 0;
+    
+    size_t stored = 0;
+    size_t idx[HASH_BATCH][CUCKOO_MAX_WAYS];
+    size_t capacity = map->capacity;
+    unsigned int seeds[CUCKOO_MAX_WAYS];
+    memcpy(seeds, map->seeds, sizeof(seeds));
+    
+    for (size_t base = 0; base < n; base += HASH_BATCH) {
+        size_t count = n - base < HASH_BATCH ? n - base : HASH_BATCH;
+        batch_slots(map, keys + base, count, idx);
         
-        if (map->table1 && map->table2) { // Allocation succeeded
-            // Update capacity and reinsert all existing entries
-            size_t old_size = map->size;
-            map->capacity = new_capacity;
-            map->size = 0;
-            init_seeds(map);  // New hash functions for new capacity
-            
-            // Reinsert all existing entries
-            bool success = true;
-            for (size_t i = 0; i < old_capacity && success; i++) {
-                if (old_table1[i].occupied) {
-                    success = cuckoo_insert_internal(map, old_table1[i].key,
-                                                     old_table1[i].value, false);
-                }
-                if (old_table2[i].occupied && success) {
-                    success = cuckoo_insert_internal(map, old_table2[i].key,
-                                                     old_table2[i].value, false);
-                }
+        for (size_t i = 0; i < count; i++) {
+            // Growth or a rehash moves every key: rehash the rest
+            grow_if_needed(map);
+            if (layout_moved(map, &capacity, seeds)) {
+                batch_slots(map, keys + base + i, count - i, idx + i);
             }
-            
-            if (success) {
-                free(old_table1);
-                free(old_table2);
-            } else {
-                // Expansion failed
-                // Restore old tables
-                free(map->table1);
-                free(map->table2);
-                map->table1 = old_table1;
-                map->table2 = old_table2;
-                map->capacity = old_capacity;
-                map->size = old_size;
+            if (cuckoo_insert_hashed(map, keys[base + i], values[base + i],
+                                     TTL_NEVER, idx[i], true)) {
+                stored++;
             }
-        } else {
-            // Allocation failed
-            // Restore old tables
-            free(map->table1);
-            free(map->table2);
-            map->table1 = old_table1;
-            map->table2 = old_table2;
+        }
+    }
+    return stored;
+}
+
+// Look for key at its precomputed candidate slots, then in the stash
+// An expired entry is a miss and is cleared on the spot
+static bool cuckoo_get_hashed(CuckooHashMap *map, int key, int *value,
+                              const size_t *idx) {
+    for (int t = 0; t < map->ways; t++) {
+        CuckooEntry *e = &map->tables[t][idx[t]];
+        STAT_INC(map, probes);
+        if (e->occupied && e->key == key) {
+            if (TTL_EXPIRED(map, e)) {
+                e->occupied = false;
+                map->size--;
+                break;  // A key is stored once, the stash cannot hold it
+            }
+            if (value) *value = e->value;
+            if (map->cache != CACHE_NONE) {
+                map->access[t][idx[t]] = cache_touch(map->cache, &map->tick);
+            }
+            STAT_INC(map, hits);
+            return true;
         }
     }
     
-    // Insert the key
-    // Return true if inserted, false if rehash needed and failed
-    return cuckoo_insert_internal(map, key, value, true);
+    // Rarely used stash, checked only when it holds keys
+    if (map->stash_count > 0) {
+        int stashed = stash_find(map, key);
+        if (stashed >= 0 && TTL_EXPIRED(map, &map->stash[stashed])) {
+            stash_remove(map, stashed);
+        } else if (stashed >= 0) {
+            if (value) *value = map->stash[stashed].value;
+            STAT_INC(map, hits);
+            return true;
+        }
+    }
+    
+    STAT_INC(map, misses);
+    return false;  // Not in any location
+}
+
+// Entry holding key at its candidate slots idx or in the stash, or NULL
+// t_out (if not NULL) receives the table, or -1 for the stash
+static CuckooEntry* find_entry(CuckooHashMap *map, int key, const size_t *idx,
+                               int *t_out) {
+    for (int t = 0; t < map->ways; t++) {
+        CuckooEntry *e = &map->tables[t][idx[t]];
+        STAT_INC(map, probes);
+        if (e->occupied && e->key == key) {
+            if (t_out) *t_out = t;
+            return e;
+        }
+    }
+    int stashed = map->stash_count > 0 ? stash_find(map, key) : -1;
+    if (stashed < 0) return NULL;
+    if (t_out) *t_out = -1;
+    return &map->stash[stashed];
+}
+
+// Return the value slot of key, inserting it with value 0 if absent, so
+// read-modify-write updates read the candidate slots once. *inserted (if
+// not NULL) tells whether the key is new. The pointer is valid until the
+// next put, delete or clear, any of which may move entries
+int* cuckoo_find_or_insert(CuckooHashMap *map, int key, bool *inserted) {
+    if (inserted) *inserted = false;
+    if (!map) return NULL;
+    
+    size_t idx[CUCKOO_MAX_WAYS];
+    candidate_slots(map, key, idx);
+    int t;
+    CuckooEntry *e = find_entry(map, key, idx, &t);
+    if (e) {
+        if (TTL_EXPIRED(map, e)) {
+            // Expired: starts over as a new key
+            e->value = 0;
+            TTL_SET(e, TTL_NEVER);
+            if (inserted) *inserted = true;
+        }
+        if (map->cache != CACHE_NONE && t >= 0) {
+            map->access[t][idx[t]] = cache_touch(map->cache, &map->tick);
+        }
+        STAT_INC(map, hits);
+        return &e->value;
+    }
+    STAT_INC(map, misses);
+    
+    // Absent: the kick chain may leave the key in any candidate slot (or
+    // growth may move everything), so look it up again once placed.
+    // A cache may also drop the key itself, which reports failure
+    size_t capacity = map->capacity;
+    unsigned int seeds[CUCKOO_MAX_WAYS];
+    memcpy(seeds, map->seeds, sizeof(seeds));
+    grow_if_needed(map);
+    if (layout_moved(map, &capacity, seeds)) candidate_slots(map, key, idx);
+    if (!cuckoo_insert_hashed(map, key, 0, TTL_NEVER, idx, true)) return NULL;
+    candidate_slots(map, key, idx);
+    e = find_entry(map, key, idx, NULL);
+    if (!e) return NULL;
+    if (inserted) *inserted = true;
+    return &e->value;
+}
+
+// Add delta to the value of key, which starts at 0 if absent
+bool cuckoo_add(CuckooHashMap *map, int key, int delta) {
+    int *slot = cuckoo_find_or_insert(map, key, NULL);
+    if (!slot) return false;
+    *slot += delta;
+    return true;
 }
 
 // Lookup: O(1) worst case
-// Check exactly 2 locations
+// Check exactly one location per table, all computed up front
 // Return true if found, false otherwise
 bool cuckoo_get(CuckooHashMap *map, int key, int *value) {
     if (!map) return false;
     
-    // Check position in table1
-    size_t idx1 = h1(map, key);
-    if (map->table1[idx1].occupied && map->table1[idx1].key == key) {
-        if (value) *value = map->table1[idx1].value;
-        return true;
-    }
+    // Candidate positions in every table
+    size_t idx[CUCKOO_MAX_WAYS];
+    candidate_slots(map, key, idx);
+    return cuckoo_get_hashed(map, key, value, idx);
+}
+
+// Look up n keys, hashing each group of HASH_BATCH keys in one pass
+// values[i] (if values is not NULL) is set and found[i] (if found is not
+// NULL) tells whether keys[i] was present. Returns the number found
+size_t cuckoo_get_batch(CuckooHashMap *map, const int *keys, int *values,
+                        bool *found, size_t n) {
+    if (!map || !keys) return 0;
     
-    // Check position in table2
-    size_t idx2 = h2(map, key);
-    if (map->table2[idx2].occupied && map->table2[idx2].key == key) {
-        if (value) *value = map->table2[idx2].value;
-        return true;
+    size_t hits = 0;
+    size_t idx[HASH_BATCH][CUCKOO_MAX_WAYS];
+    for (size_t base = 0; base < n; base += HASH_BATCH) {
+        size_t count = n - base < HASH_BATCH ? n - base : HASH_BATCH;
+        batch_slots(map, keys + base, count, idx);
+        for (size_t i = 0; i < count; i++) {
+            bool hit = cuckoo_get_hashed(map, keys[base + i],
+                                         values ? &values[base + i] : NULL,
+                                         idx[i]);
+            if (found) found[base + i] = hit;
+            if (hit) hits++;
+        }
     }
-    
-    return false;  // Not in either location
+    return hits;
 }
 
 // Delete: O(1) worst case
-// Check exactly 2 locations
+// Check exactly one location per table
 // Return true if deleted, false if not found
 bool cuckoo_delete(CuckooHashMap *map, int key) {
     if (!map) return false;
     
-    // Check table1
-    size_t idx1 = h1(map, key);
-    if (map->table1[idx1].occupied && map->table1[idx1].key == key) {
-        map->table1[idx1].occupied = false;  // Mark as empty
-        map->size--;
-        return true;
+    size_t idx[CUCKOO_MAX_WAYS];
+    candidate_slots(map, key, idx);
+    
+    for (int t = 0; t < map->ways; t++) {
+        CuckooEntry *e = &map->tables[t][idx[t]];
+        STAT_INC(map, probes);
+        if (e->occupied && e->key == key) {
+            // An expired key is already gone, but its slot is freed here
+            bool live = !TTL_EXPIRED(map, e);
+            e->occupied = false;  // Mark as empty
+            map->size--;
+            return live;
+        }
     }
     
-    // Check table2
-    size_t idx2 = h2(map, key);
-    if (map->table2[idx2].occupied && map->table2[idx2].key == key) {
-        map->table2[idx2].occupied = false;  // Mark as empty
-        map->size--;
-        return true;
+    // Check the stash, keeping it packed
+    if (map->stash_count > 0) {
+        int stashed = stash_find(map, key);
+        if (stashed >= 0) {
+            bool live = !TTL_EXPIRED(map, &map->stash[stashed]);
+            stash_remove(map, stashed);
+            return live;
+        }
     }
     
     return false;  // Key not found
@@ -382,8 +934,10 @@ size_t cuckoo_size(CuckooHashMap *map) {
 // Calculate total memory usage
 size_t cuckoo_memory_usage(CuckooHashMap *map) {
     if (!map) return 0;
-    // Main struct + both tables
-    return sizeof(CuckooHashMap) + 2 * map->capacity * sizeof(CuckooEntry);
+    // Main struct + every table (+ access words in cache mode)
+    size_t slot_bytes = sizeof(CuckooEntry) +
+                        (map->cache != CACHE_NONE ? sizeof(uint32_t) : 0);
+    return sizeof(CuckooHashMap) + (size_t)map->ways * map->capacity * slot_bytes;
 }
 
 // Return number of rehashes
@@ -392,9 +946,146 @@ int cuckoo_rehash_count(CuckooHashMap *map) {
     return map ? map->rehash_count : 0;
 }
 
+// Return number of keys evicted in cache mode
+size_t cuckoo_evictions(CuckooHashMap *map) {
+    return map ? map->evictions : 0;
+}
+
 // Calculate current load factor
-// Load = elements / (2 * capacity) since we have 2 tables
+// Load = elements / (ways * capacity) since we have one table per way
 double cuckoo_load_factor(CuckooHashMap *map) {
     if (!map || map->capacity == 0) return 0.0;
-    return (double)map->size / (2.0 * map->capacity);
-}
\ No newline at end of file
+    return (double)map->size / ((double)map->ways * map->capacity);
+}
+
+// Fill hist[t] with the number of keys residing in table t
+// hist[0..ways-1] count the tables (hist[0] is the first choice),
+// hist[ways] the stash. Extra locations fold into the last bin
+// Returns the number of bins filled
+size_t cuckoo_table_histogram(CuckooHashMap *map, size_t *hist, size_t bins) {
+    if (!map || !hist || bins == 0) return 0;
+    
+    size_t counts[CUCKOO_MAX_WAYS + 1] = {0};
+    // One pass over every table
+    for (int t = 0; t < map->ways; t++) {
+        for (size_t i = 0; i < map->capacity; i++) {
+            if (map->tables[t][i].occupied) counts[t]++;
+        }
+    }
+    size_t locations = (size_t)map->ways + 1;
+    counts[map->ways] = (size_t)map->stash_count;
+    
+    for (size_t k = 0; k < bins; k++) hist[k] = 0;
+    for (size_t k = 0; k < locations; k++) {
+        hist[k < bins ? k : bins - 1] += counts[k];
+    }
+    return bins < locations ? bins : locations;
+}
+
+// Build a read-only minimal perfect hash copy of the current contents
+// The map itself is left untouched and may keep changing
+FrozenMap* cuckoo_freeze(CuckooHashMap *map) {
+    if (!map) return NULL;
+    
+    size_t n = map->size;
+    int *keys = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *values = malloc((n > 0 ? n : 1) * sizeof(int));
+    FrozenMap *frozen = NULL;
+    if (keys && values) {
+        // Every table, then the stash
+        size_t k = 0;
+        for (int t = 0; t < map->ways; t++) {
+            for (size_t i = 0; i < map->capacity; i++) {
+                if (map->tables[t][i].occupied &&
+                    !TTL_EXPIRED(map, &map->tables[t][i])) {
+                    keys[k] = map->tables[t][i].key;
+                    values[k] = map->tables[t][i].value;
+                    k++;
+                }
+            }
+        }
+        for (int s = 0; s < map->stash_count; s++) {
+            if (TTL_EXPIRED(map, &map->stash[s])) continue;
+            keys[k] = map->stash[s].key;
+            values[k] = map->stash[s].value;
+            k++;
+        }
+        frozen = frozen_build(keys, values, k, prng_next(&map->rng));
+    }
+    free(keys);
+    free(values);
+    return frozen;
+}
+
+// Copy operational counters into out
+// Returns false (and zeroes out) when built without HASHMAP_STATS
+bool cuckoo_stats(CuckooHashMap *map, CuckooStats *out) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+#ifdef HASHMAP_STATS
+    if (!map) return false;
+    *out = map->stats;
+    return true;
+#else
+    (void)map;
+    return false;
+#endif
+}
+// Insert or update a pair that expires ttl ticks after the current map time
+// A ttl of 0 never expires. Returns false when built without HASHMAP_TTL
+bool cuckoo_put_ttl(CuckooHashMap *map, int key, int value, uint64_t ttl) {
+#ifdef HASHMAP_TTL
+    if (!map) return false;
+    grow_if_needed(map);
+    return cuckoo_insert_internal(map, key, value, ttl_deadline(map->now, ttl),
+                                  true);
+#else
+    (void)map; (void)key; (void)value; (void)ttl;
+    return false;
+#endif
+}
+
+// Set the map clock; entries whose deadline is at or before now are expired
+void cuckoo_set_time(CuckooHashMap *map, uint64_t now) {
+#ifdef HASHMAP_TTL
+    if (map) map->now = now;
+#else
+    (void)map; (void)now;
+#endif
+}
+
+// Clear expired entries in the next max_slots slots (numbered across all
+// tables), resuming where the previous call stopped, so the cost per call
+// is bounded. The stash is swept each time the cursor wraps around
+// Returns the number of entries removed
+size_t cuckoo_expire_step(CuckooHashMap *map, size_t max_slots) {
+#ifdef HASHMAP_TTL
+    if (!map) return 0;
+    size_t cap = map->capacity;
+    size_t total = (size_t)map->ways * cap;
+    if (max_slots > total) max_slots = total;
+    
+    size_t removed = 0;
+    for (size_t n = 0; n < max_slots; n++) {
+        size_t i = map->sweep_cursor;
+        CuckooEntry *e = &map->tables[i / cap][i % cap];
+        if (e->occupied && TTL_EXPIRED(map, e)) {
+            e->occupied = false;
+            map->size--;
+            removed++;
+        }
+        if (++map->sweep_cursor < total) continue;
+        map->sweep_cursor = 0;
+        for (int s = map->stash_count - 1; s >= 0; s--) {
+            if (TTL_EXPIRED(map, &map->stash[s])) {
+                stash_remove(map, s);
+                removed++;
+            }
+        }
+    }
+    return removed;
+#else
+    (void)map; (void)max_slots;
+    return 0;
+#endif
+}
@@ -10,32 +10,107 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include "hashmap_stats.h"
+#include "hashmap_ttl.h"
+#include "table_alloc.h"
+#include "prng.h"
+#include "frozen.h"
+#include "cache_policy.h"
+
+// Default number of stash slots for keys whose eviction chain fails
+#define CUCKOO_STASH_SIZE 4
+
+// Largest stash a map may be created with
+#define CUCKOO_MAX_STASH 16
+
+// Most sub-tables (hash functions) a d-ary map may use
+#define CUCKOO_MAX_WAYS 4
 
 // Entry structure for cuckoo hash slots
 typedef struct {
     int key;        // Key stored in slot
     int value;      // Value associated with key
     bool occupied;  // Whether slot contains valid data
+#ifdef HASHMAP_TTL
+    uint64_t expires; // Deadline on the map clock, TTL_NEVER if none
+#endif
 } CuckooEntry;
 
+// Operational counters, filled only when built with HASHMAP_STATS
+typedef struct {
+    size_t probes;          // Slots inspected by put/get/delete
+    size_t hits;            // Successful lookups
+    size_t misses;          // Failed lookups
+    size_t displacements;   // Total evictions during insertion
+    size_t kick_chains;     // Insertions that evicted at least one key
+    size_t max_kick_chain;  // Longest eviction chain seen
+    size_t resizes;         // Table expansions
+    double resize_ms;       // Time spent expanding and rehashing
+    size_t stashed;         // Failed eviction chains absorbed by the stash
+} CuckooStats;
+
+// Creation options for cuckoo_create_with
+// A zeroed struct gives the same map as cuckoo_create
+typedef struct {
+    TableAllocOptions alloc;  // How both tables are allocated
+    unsigned long long seed;  // Seed for the map's PRNG, 0 picks one from time
+    int stash_size;           // Stash slots, 0 = CUCKOO_STASH_SIZE, negative = no stash
+    double max_load;          // Load factor that triggers growth, 0 = default for ways
+    int ways;                 // Sub-tables / hash functions (2-4), 0 = 2
+    CachePolicy cache;        // Bounded cache mode (never grows, no stash), CACHE_NONE = plain map
+    int resize_threads;       // Threads moving entries in growth and rehashes, 0 = 1
+} CuckooOptions;
+
 // Main cuckoo hash map structure
 typedef struct {
-    CuckooEntry *table1;   // First hash table
-    CuckooEntry *table2;   // Second hash table
+    CuckooEntry *tables[CUCKOO_MAX_WAYS]; // One hash table per way
+    int ways;              // Number of tables in use (d)
     size_t capacity;       // Capacity of EACH table
-    size_t size;           // Total elements across both tables
-    unsigned int seed1;    // Seed for first hash function
-    unsigned int seed2;    // Seed for second hash function
+    size_t size;           // Total elements across all tables
+    unsigned int seeds[CUCKOO_MAX_WAYS]; // Seed for each hash function
     int rehash_count;      // Number of rehashes performed
+    CuckooEntry stash[CUCKOO_MAX_STASH]; // Overflow for failed insertions
+    int stash_capacity;    // Usable stash slots
+    int stash_count;       // Keys currently in the stash (packed at the front)
+    double max_load;       // Growth threshold
+    int resize_threads;    // Threads used to move entries into new tables
+    TableAllocOptions alloc; // Allocation mode of both tables
+    Prng rng;              // Private generator for hash seeds
+    CachePolicy cache;     // Eviction policy, CACHE_NONE for a plain map
+    uint32_t *access[CUCKOO_MAX_WAYS]; // Reference bit / LRU stamp per slot (cache mode only)
+    size_t clock_hand;     // Next slot (over all tables) the CLOCK sweep inspects
+    uint32_t tick;         // Logical clock for LRU stamps
+    size_t evictions;      // Keys evicted to make room
+#ifdef HASHMAP_STATS
+    CuckooStats stats;     // Operational counters
+#endif
+#ifdef HASHMAP_TTL
+    uint64_t now;          // Map clock that deadlines are compared against
+    size_t sweep_cursor;   // Next slot (over all tables) for cuckoo_expire_step
+#endif
 } CuckooHashMap;
 
 CuckooHashMap* cuckoo_create(size_t capacity); // Initialize cuckoo hash map
+CuckooHashMap* cuckoo_create_with(size_t capacity, const CuckooOptions *opts); // Initialize with options (NULL for defaults)
 void cuckoo_destroy(CuckooHashMap *map); // Free resources used by cuckoo hash map
+void cuckoo_clear(CuckooHashMap *map); // Remove all entries, keeping the tables for reuse
 bool cuckoo_put(CuckooHashMap *map, int key, int value); // Insert key value pair
 bool cuckoo_get(CuckooHashMap *map, int key, int *value); // Retrieve value for key
+int* cuckoo_find_or_insert(CuckooHashMap *map, int key, bool *inserted); // Value slot of key, inserting 0 if absent (inserted may be NULL). Valid until the next mutation, NULL on failure
+bool cuckoo_add(CuckooHashMap *map, int key, int delta); // Add delta to key's value, starting from 0 if absent
+size_t cuckoo_put_batch(CuckooHashMap *map, const int *keys, const int *values, size_t n); // Insert n pairs, hashing keys in vector batches. Returns pairs stored
+size_t cuckoo_get_batch(CuckooHashMap *map, const int *keys, int *values, bool *found, size_t n); // Look up n keys (values, found may be NULL). Returns keys found
 bool cuckoo_delete(CuckooHashMap *map, int key); // Remove key-value pair
+bool cuckoo_resize(CuckooHashMap *map, size_t new_capacity); // Move every entry into tables of new_capacity slots each (not in cache mode)
 size_t cuckoo_size(CuckooHashMap *map); // Get number of elements in map
 size_t cuckoo_memory_usage(CuckooHashMap *map); // Get total memory usage in bytes
+FrozenMap* cuckoo_freeze(CuckooHashMap *map); // Build a read-only perfect hash copy (map is unchanged). NULL on failure
 int cuckoo_rehash_count(CuckooHashMap *map); // Get number of rehashes performed
+size_t cuckoo_evictions(CuckooHashMap *map); // Get number of keys evicted in cache mode
 double cuckoo_load_factor(CuckooHashMap *map); // Get current load factor
+size_t cuckoo_table_histogram(CuckooHashMap *map, size_t *hist, size_t bins); // Count keys per table, then stash. Returns bins filled
+bool cuckoo_stats(CuckooHashMap *map, CuckooStats *out); // Copy counters. Returns false if stats are compiled out
+bool cuckoo_put_ttl(CuckooHashMap *map, int key, int value, uint64_t ttl); // Insert or update a pair that expires ttl ticks from now (0 = never). False if TTL is compiled out
+void cuckoo_set_time(CuckooHashMap *map, uint64_t now); // Advance the map clock used for expiry
+size_t cuckoo_expire_step(CuckooHashMap *map, size_t max_slots); // Reclaim expired entries from at most max_slots slots. Returns entries removed
 #endif
\ No newline at end of file
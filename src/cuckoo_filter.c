@@ -0,0 +1,306 @@
+/*
+ * Cuckoo Filter Implementation
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * Cuckoo Filter Implementation is based on: Fan, B., Andersen, D. G.,
+ * Kaminsky, M., & Mitzenmacher, M. D. (2014). Cuckoo filter: Practically
+ * better than Bloom. In Proceedings of CoNEXT '14, 75-88.
+ * Approximate membership: each key is reduced to a small fingerprint
+ * stored in one of two buckets of CUCKOO_FILTER_SLOTS slots. The second
+ * bucket is derived from the first and the fingerprint alone (partial-key
+ * cuckoo hashing), so a fingerprint can be kicked to its other bucket
+ * without the key, using the same bounded displacement walk as
+ * cuckoo_insert_hashed. A key is never reported absent after it was
+ * inserted; an absent key is reported present with probability about
+ * 2 * CUCKOO_FILTER_SLOTS * load / 2^bits.
+ */
+
+#include "cuckoo_filter.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Maximum displacement attempts before a fingerprint is left homeless
+#define MAX_KICKS 500
+
+// Highest load the table is sized for; kicks get long beyond ~95%
+#define CUCKOO_FILTER_MAX_LOAD 0.95
+
+/* Hash function using MurmurHash-inspired bit mixing
+* Code adapted from Appleby, A. (2011). MurmurHash3 fmix32() finalizer.
+* Retrieved from https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp.
+* The bit-mixing sequence and associated constants in the hash_with_seed function
+* were adapted from the fmix32() finalizer of MurmurHash3.
+*/
+static uint32_t hash_with_seed(uint32_t k, unsigned int seed) {
+    k ^= seed;           // Mix in the seed
+    k ^= (k >> 16);      // Mix high bits down
+    k *= 0x85ebca6b;     // Multiply by magic constant
+    k ^= (k >> 13);      // More mixing
+    k *= 0xc2b2ae35;     // Another constant
+    k ^= (k >> 16);      // Final mix
+    return k;
+}
+
+// Number of 64-bit words holding the packed table, plus one so a field
+// that ends in the last word can always read the word after it
+static size_t word_count(size_t buckets, int bits) {
+    size_t total = buckets * CUCKOO_FILTER_SLOTS * (size_t)bits;
+    return (total + 63) / 64 + 1;
+}
+
+// Fingerprint in slot s of bucket b (0 = empty)
+static uint32_t get_fp(CuckooFilter *filter, size_t b, int s) {
+    int f = filter->fingerprint_bits;
+    size_t pos = (b * CUCKOO_FILTER_SLOTS + (size_t)s) * (size_t)f;
+    size_t w = pos / 64;
+    int off = (int)(pos % 64);
+    uint64_t v = filter->bits[w] >> off;
+    if (off + f > 64) v |= filter->bits[w + 1] << (64 - off);
+    return (uint32_t)(v & ((1u << f) - 1));
+}
+
+// Store fingerprint fp in slot s of bucket b
+static void set_fp(CuckooFilter *filter, size_t b, int s, uint32_t fp) {
+    int f = filter->fingerprint_bits;
+    size_t pos = (b * CUCKOO_FILTER_SLOTS + (size_t)s) * (size_t)f;
+    size_t w = pos / 64;
+    int off = (int)(pos % 64);
+    uint64_t mask = (uint64_t)((1u << f) - 1);
+    filter->bits[w] = (filter->bits[w] & ~(mask << off)) | ((uint64_t)fp << off);
+    if (off + f > 64) {
+        int spill = 64 - off;  // Bits already written to word w
+        filter->bits[w + 1] = (filter->bits[w + 1] & ~(mask >> spill)) |
+                              ((uint64_t)fp >> spill);
+    }
+}
+
+// Fingerprint of key in 1 .. 2^bits - 1, so 0 can mark an empty slot
+static uint32_t fingerprint(CuckooFilter *filter, int key) {
+    uint32_t range = (1u << filter->fingerprint_bits) - 1;
+    return hash_with_seed((uint32_t)key, filter->fp_seed) % range + 1;
+}
+
+// First bucket of key
+static size_t home_bucket(CuckooFilter *filter, int key) {
+    return hash_with_seed((uint32_t)key, filter->seed) & (filter->buckets - 1);
+}
+
+// The other bucket of a fingerprint stored in bucket b
+// XOR with a hash of the fingerprint is its own inverse, so the same call
+// maps either bucket to the other one
+static size_t alt_bucket(CuckooFilter *filter, size_t b, uint32_t fp) {
+    return (b ^ hash_with_seed(fp, filter->seed)) & (filter->buckets - 1);
+}
+
+// Put fp in a free slot of bucket b. Returns false if the bucket is full
+static bool bucket_insert(CuckooFilter *filter, size_t b, uint32_t fp) {
+    for (int s = 0; s < CUCKOO_FILTER_SLOTS; s++) {
+        if (get_fp(filter, b, s) == 0) {
+            set_fp(filter, b, s, fp);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Clear one slot of bucket b holding fp. Returns false if there is none
+static bool bucket_remove(CuckooFilter *filter, size_t b, uint32_t fp) {
+    for (int s = 0; s < CUCKOO_FILTER_SLOTS; s++) {
+        if (get_fp(filter, b, s) == fp) {
+            set_fp(filter, b, s, 0);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Whether bucket b holds fp
+// A bucket is at most 64 bits, so it is read once and split in registers
+static bool bucket_contains(CuckooFilter *filter, size_t b, uint32_t fp) {
+    int f = filter->fingerprint_bits;
+    size_t pos = b * CUCKOO_FILTER_SLOTS * (size_t)f;
+    size_t w = pos / 64;
+    int off = (int)(pos % 64);
+    uint64_t v = filter->bits[w] >> off;
+    if (off + CUCKOO_FILTER_SLOTS * f > 64) v |= filter->bits[w + 1] << (64 - off);
+    uint64_t mask = (uint64_t)((1u << f) - 1);
+    for (int s = 0; s < CUCKOO_FILTER_SLOTS; s++) {
+        if (((v >> (s * f)) & mask) == fp) return true;
+    }
+    return false;
+}
+
+// Store fp in bucket b or its alternate, kicking random residents to
+// their other bucket when both are full. After MAX_KICKS the fingerprint
+// in hand becomes the victim, so no stored key is ever lost
+static void place(CuckooFilter *filter, size_t b, uint32_t fp) {
+    size_t alt = alt_bucket(filter, b, fp);
+    if (bucket_insert(filter, b, fp) || bucket_insert(filter, alt, fp)) return;
+
+    if (prng_next(&filter->rng) & 1) b = alt;  // Start the walk at either bucket
+    for (int kick = 0; kick < MAX_KICKS; kick++) {
+        // Swap with a random resident, which moves to its other bucket
+        int s = (int)(prng_next(&filter->rng) % CUCKOO_FILTER_SLOTS);
+        uint32_t evicted = get_fp(filter, b, s);
+        set_fp(filter, b, s, fp);
+        fp = evicted;
+        b = alt_bucket(filter, b, fp);
+        if (bucket_insert(filter, b, fp)) return;
+    }
+    filter->has_victim = true;
+    filter->victim_bucket = b;
+    filter->victim_fp = fp;
+}
+
+// Create a filter for about capacity keys
+CuckooFilter* cuckoo_filter_create(size_t capacity) {
+    return cuckoo_filter_create_with(capacity, NULL);
+}
+
+// Create a filter for about capacity keys with creation options
+CuckooFilter* cuckoo_filter_create_with(size_t capacity,
+                                        const CuckooFilterOptions *opts) {
+    int bits = (opts && opts->fingerprint_bits) ? opts->fingerprint_bits
+                                                : CUCKOO_FILTER_DEFAULT_BITS;
+    if (bits < 2 || bits > CUCKOO_FILTER_MAX_BITS) return NULL;  // Unsupported
+
+    CuckooFilter *filter = malloc(sizeof(CuckooFilter));
+    if (!filter) return NULL;
+
+    // Power-of-two bucket count, so alt_bucket stays inside the table
+    size_t buckets = 1;
+    while (buckets * CUCKOO_FILTER_SLOTS * CUCKOO_FILTER_MAX_LOAD < capacity) {
+        buckets <<= 1;
+    }
+    filter->bits = calloc(word_count(buckets, bits), sizeof(uint64_t));
+    if (!filter->bits) {
+        free(filter);
+        return NULL;
+    }
+
+    filter->buckets = buckets;
+    filter->size = 0;
+    filter->fingerprint_bits = bits;
+    filter->has_victim = false;
+    filter->victim_bucket = 0;
+    filter->victim_fp = 0;
+
+    // Per-filter generator: reproducible when the caller passes a seed
+    uint64_t seed = (opts && opts->seed) ? opts->seed : prng_default_seed(filter);
+    prng_seed(&filter->rng, seed);
+    filter->seed = (unsigned int)prng_next(&filter->rng);
+    do {
+        filter->fp_seed = (unsigned int)prng_next(&filter->rng);
+    } while (filter->fp_seed == filter->seed);  // Independent hashes
+    return filter;
+}
+
+// Free all memory
+void cuckoo_filter_destroy(CuckooFilter *filter) {
+    if (!filter) return;
+    free(filter->bits);  // Free packed table
+    free(filter);        // Free main struct
+}
+
+// Remove every fingerprint but keep the table for reuse
+void cuckoo_filter_clear(CuckooFilter *filter) {
+    if (!filter) return;
+    memset(filter->bits, 0,
+           word_count(filter->buckets, filter->fingerprint_bits) * sizeof(uint64_t));
+    filter->size = 0;
+    filter->has_victim = false;
+}
+
+// Add a key. Inserting a key twice stores two copies, which lets each
+// delete pair with one insert
+// Returns false, without changing the filter, once a kick chain has failed
+bool cuckoo_filter_insert(CuckooFilter *filter, int key) {
+    if (!filter) return false;
+    if (filter->has_victim) return false;  // Full: the victim has no room
+
+    place(filter, home_bucket(filter, key), fingerprint(filter, key));
+    filter->size++;
+    return true;
+}
+
+// Whether key may be present
+// Two buckets (and the victim) are read whether the key is there or not
+bool cuckoo_filter_contains(CuckooFilter *filter, int key) {
+    if (!filter) return false;
+
+    uint32_t fp = fingerprint(filter, key);
+    size_t b1 = home_bucket(filter, key);
+    size_t b2 = alt_bucket(filter, b1, fp);
+    if (filter->has_victim && filter->victim_fp == fp &&
+        (filter->victim_bucket == b1 || filter->victim_bucket == b2)) {
+        return true;
+    }
+    return bucket_contains(filter, b1, fp) || bucket_contains(filter, b2, fp);
+}
+
+// Remove one copy of a key that was inserted
+// Deleting a key that was never inserted may remove a colliding key's
+// fingerprint, which would make that key a false negative
+bool cuckoo_filter_delete(CuckooFilter *filter, int key) {
+    if (!filter) return false;
+
+    uint32_t fp = fingerprint(filter, key);
+    size_t b1 = home_bucket(filter, key);
+    size_t b2 = alt_bucket(filter, b1, fp);
+    if (filter->has_victim && filter->victim_fp == fp &&
+        (filter->victim_bucket == b1 || filter->victim_bucket == b2)) {
+        filter->has_victim = false;
+        filter->size--;
+        return true;
+    }
+    if (!bucket_remove(filter, b1, fp) && !bucket_remove(filter, b2, fp)) {
+        return false;  // Not found
+    }
+    filter->size--;
+
+    // A slot is free again: give the victim another chance
+    if (filter->has_victim) {
+        filter->has_victim = false;
+        place(filter, filter->victim_bucket, filter->victim_fp);
+    }
+    return true;
+}
+
+// Return number of stored fingerprints
+size_t cuckoo_filter_size(CuckooFilter *filter) {
+    return filter ? filter->size : 0;
+}
+
+// Calculate total memory usage
+size_t cuckoo_filter_memory_usage(CuckooFilter *filter) {
+    if (!filter) return 0;
+    // Main struct + packed fingerprint table
+    return sizeof(CuckooFilter) +
+           word_count(filter->buckets, filter->fingerprint_bits) * sizeof(uint64_t);
+}
+
+// Fraction of fingerprint slots in use
+double cuckoo_filter_load_factor(CuckooFilter *filter) {
+    if (!filter) return 0.0;
+    return (double)filter->size / ((double)filter->buckets * CUCKOO_FILTER_SLOTS);
+}
+
+// Table bits per stored key (fingerprint_bits / load)
+double cuckoo_filter_bits_per_key(CuckooFilter *filter) {
+    if (!filter || filter->size == 0) return 0.0;
+    return (double)filter->buckets * CUCKOO_FILTER_SLOTS *
+           filter->fingerprint_bits / filter->size;
+}
+
+// False positive rate predicted at the current load: a lookup compares its
+// fingerprint with 2 * CUCKOO_FILTER_SLOTS slots, each occupied with
+// probability load and matching with probability 1 / (2^bits - 1)
+double cuckoo_filter_expected_fpr(CuckooFilter *filter) {
+    if (!filter) return 0.0;
+    double miss = 1.0 - 1.0 / (double)((1u << filter->fingerprint_bits) - 1);
+    double compared = 2.0 * CUCKOO_FILTER_SLOTS * cuckoo_filter_load_factor(filter);
+    return 1.0 - pow(miss, compared);
+}
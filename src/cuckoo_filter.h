@@ -0,0 +1,61 @@
+/*
+ * Cuckoo Filter Header
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ */
+
+#ifndef CUCKOO_FILTER_H // Include guard
+#define CUCKOO_FILTER_H // Prevent multiple inclusions
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "prng.h"
+
+// Fingerprints per bucket
+#define CUCKOO_FILTER_SLOTS 4
+
+// Fingerprint size used when the options leave it at 0
+#define CUCKOO_FILTER_DEFAULT_BITS 12
+
+// Largest fingerprint size (a bucket then fits one 64-bit word)
+#define CUCKOO_FILTER_MAX_BITS 16
+
+// Creation options for cuckoo_filter_create_with
+// A zeroed struct gives the same filter as cuckoo_filter_create
+typedef struct {
+    int fingerprint_bits;  // Bits per fingerprint (2-16), 0 = CUCKOO_FILTER_DEFAULT_BITS
+    uint64_t seed;         // PRNG seed for hash seeds and kicks, 0 = random per filter
+} CuckooFilterOptions;
+
+// Main filter structure
+// Fingerprints are packed fingerprint_bits apart in a bit array, so the
+// table costs CUCKOO_FILTER_SLOTS * fingerprint_bits bits per bucket
+typedef struct {
+    uint64_t *bits;         // Packed fingerprints, 0 = empty slot
+    size_t buckets;         // Number of buckets (a power of two)
+    size_t size;            // Fingerprints stored, including the victim
+    int fingerprint_bits;   // Bits per fingerprint
+    unsigned int seed;      // Seed for the bucket index hash
+    unsigned int fp_seed;   // Seed for the fingerprint hash
+    bool has_victim;        // A fingerprint left homeless by a failed kick chain
+    size_t victim_bucket;   // One of its two buckets
+    uint32_t victim_fp;     // The homeless fingerprint
+    Prng rng;               // Per-filter generator for kick choices
+} CuckooFilter;
+
+CuckooFilter* cuckoo_filter_create(size_t capacity); // Create a filter for about capacity keys
+CuckooFilter* cuckoo_filter_create_with(size_t capacity, const CuckooFilterOptions *opts); // Create with options (NULL for defaults)
+void cuckoo_filter_destroy(CuckooFilter *filter); // Destroy the filter and free memory
+void cuckoo_filter_clear(CuckooFilter *filter); // Remove all fingerprints, keeping the table for reuse
+bool cuckoo_filter_insert(CuckooFilter *filter, int key); // Add a key (not idempotent). False when the filter is full
+bool cuckoo_filter_contains(CuckooFilter *filter, int key); // Whether key may be present (never false for an inserted key)
+bool cuckoo_filter_delete(CuckooFilter *filter, int key); // Remove one copy of a key that was inserted
+size_t cuckoo_filter_size(CuckooFilter *filter); // Get number of stored fingerprints
+size_t cuckoo_filter_memory_usage(CuckooFilter *filter); // Get total memory usage in bytes
+double cuckoo_filter_load_factor(CuckooFilter *filter); // Get fraction of fingerprint slots in use
+double cuckoo_filter_bits_per_key(CuckooFilter *filter); // Get table bits per stored key
+double cuckoo_filter_expected_fpr(CuckooFilter *filter); // Get false positive rate predicted at the current load
+
+#endif
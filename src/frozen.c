@@ -0,0 +1,246 @@
+/*
+ * Frozen (Read-Only) Hash Map Implementation
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * Minimal perfect hashing follows CHD: Belazzougui, D., Botelho, F. C., &
+ * Dietzfelbinger, M. (2009). Hash, displace, and compress. In ESA 2009,
+ * LNCS 5757, 682-693, with the pilot search of PTHash (Pibiri and Trani,
+ * SIGIR 2021).
+ * Keys are split into n / FROZEN_BUCKET_SIZE buckets. Buckets are placed
+ * largest first: for each one the builder tries pilots 0, 1, 2 ... until
+ * every key of the bucket lands on a free slot. Hashing into n / alpha
+ * slots instead of n keeps the last buckets from searching for the final
+ * few free slots; the keys that land past n are moved into the holes
+ * below n through a small remap array. A lookup hashes the key, reads its
+ * bucket's pilot (a small array, about one byte per key) and then reads
+ * exactly one entry; there is no probing and no empty slot, so the table
+ * holds n entries.
+ */
+
+#include "frozen.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Seeds tried before giving up (each failure is vanishingly unlikely)
+#define FROZEN_MAX_ATTEMPTS 16
+
+// Multiplier spreading consecutive pilots over the 64-bit hash space
+#define PILOT_MIX 0x9e3779b97f4a7c15ULL
+
+/* 64-bit finalizer used for key and position hashing
+* Code adapted from Steele, G. L., Lea, D., & Flood, C. H. (2014). Fast
+* splittable pseudorandom number generators. OOPSLA 2014 (SplitMix64 mix).
+*/
+static uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Full hash of a key: bijective, so distinct keys never share it
+static uint64_t key_hash(int key, uint64_t seed) {
+    return mix64((uint64_t)(uint32_t)key ^ seed);
+}
+
+// Bucket of a key hash
+static size_t bucket_of(uint64_t kh, size_t buckets) {
+    return (size_t)((kh >> 32) % buckets);
+}
+
+// Hash slot of a key hash under a pilot, in 0 .. range - 1
+static size_t slot_of(uint64_t kh, uint32_t pilot, size_t range) {
+    return (size_t)(mix64(kh ^ ((uint64_t)pilot * PILOT_MIX)) % range);
+}
+
+// Try one seed: fill pilots and order[] (key index per hash slot, range
+// slots). Returns false if some bucket exhausts its pilots (retry with a
+// new seed)
+static bool build_with_seed(const int *keys, size_t n, size_t range,
+                            size_t buckets, uint64_t seed, uint32_t *pilots,
+                            size_t *order) {
+    uint64_t *kh = malloc(n * sizeof(uint64_t));
+    size_t *start = calloc(buckets + 1, sizeof(size_t));
+    size_t *members = malloc(n * sizeof(size_t));
+    size_t *by_size = malloc(buckets * sizeof(size_t));
+    bool *taken = calloc(range, sizeof(bool));
+    bool ok = kh && start && members && by_size && taken;
+    for (size_t s = 0; s < range; s++) order[s] = SIZE_MAX;  // All free
+    
+    if (ok) {
+        // Group key indexes by bucket (counting sort)
+        for (size_t i = 0; i < n; i++) {
+            kh[i] = key_hash(keys[i], seed);
+            start[bucket_of(kh[i], buckets) + 1]++;
+        }
+        size_t largest = 0;
+        for (size_t b = 0; b < buckets; b++) {
+            if (start[b + 1] > largest) largest = start[b + 1];
+            start[b + 1] += start[b];
+        }
+        size_t *fill = calloc(buckets, sizeof(size_t));
+        size_t *count = calloc(largest + 2, sizeof(size_t));
+        ok = fill && count;
+        if (ok) {
+            for (size_t i = 0; i < n; i++) {
+                size_t b = bucket_of(kh[i], buckets);
+                members[start[b] + fill[b]++] = i;
+            }
+            // Order buckets largest first (counting sort on size)
+            for (size_t b = 0; b < buckets; b++) {
+                count[largest - (start[b + 1] - start[b]) + 1]++;
+            }
+            for (size_t s = 0; s <= largest; s++) count[s + 1] += count[s];
+            for (size_t b = 0; b < buckets; b++) {
+                by_size[count[largest - (start[b + 1] - start[b])]++] = b;
+            }
+        }
+        free(fill);
+        free(count);
+    }
+    
+    // Expected tries stay below 1 / (1 - alpha), so this is generous
+    uint64_t limit = (uint64_t)range * 4 + 1024;
+    if (limit > UINT32_MAX) limit = UINT32_MAX;
+    
+    size_t slots[FROZEN_BUCKET_SIZE * 16];
+    for (size_t k = 0; k < buckets && ok; k++) {
+        size_t b = by_size[k];
+        size_t len = start[b + 1] - start[b];
+        const size_t *m = members + start[b];
+        pilots[b] = 0;
+        if (len == 0) continue;  // Empty buckets keep pilot 0
+        if (len > sizeof(slots) / sizeof(slots[0])) {
+            ok = false;  // Pathologically skewed seed
+            break;
+        }
+        
+        uint64_t p;
+        for (p = 0; p < limit; p++) {
+            bool fits = true;
+            for (size_t i = 0; i < len && fits; i++) {
+                slots[i] = slot_of(kh[m[i]], (uint32_t)p, range);
+                fits = !taken[slots[i]];
+                for (size_t j = 0; j < i && fits; j++) {
+                    fits = slots[j] != slots[i];  // Bucket must not self-collide
+                }
+            }
+            if (fits) break;
+        }
+        if (p == limit) {
+            ok = false;
+            break;
+        }
+        
+        pilots[b] = (uint32_t)p;
+        for (size_t i = 0; i < len; i++) {
+            taken[slots[i]] = true;
+            order[slots[i]] = m[i];
+        }
+    }
+    
+    free(kh);
+    free(start);
+    free(members);
+    free(by_size);
+    free(taken);
+    return ok;
+}
+
+// Build a frozen map from n distinct keys and their values
+// Returns NULL if memory runs out or the keys are not distinct
+FrozenMap* frozen_build(const int *keys, const int *values, size_t n,
+                        uint64_t seed) {
+    if (n > 0 && (!keys || !values)) return NULL;
+    
+    // Allocate main structure
+    FrozenMap *map = malloc(sizeof(FrozenMap));
+    if (!map) return NULL;
+    map->size = n;
+    map->range = (size_t)(n / FROZEN_ALPHA) + 1;
+    map->buckets = n / FROZEN_BUCKET_SIZE + 1;
+    map->entries = malloc((n > 0 ? n : 1) * sizeof(FrozenEntry));
+    map->pilots = calloc(map->buckets, sizeof(uint32_t));
+    map->remap = calloc(map->range - n, sizeof(uint32_t));
+    size_t *order = malloc(map->range * sizeof(size_t));
+    if (!map->entries || !map->pilots || !map->remap || !order) {
+        free(order);
+        frozen_destroy(map);
+        return NULL;
+    }
+    
+    // Nothing to place: every lookup misses
+    map->seed = mix64(seed);
+    if (n == 0) {
+        free(order);
+        return map;
+    }
+    
+    // A new seed per attempt, all derived from the caller's
+    bool built = false;
+    for (int attempt = 0; attempt < FROZEN_MAX_ATTEMPTS && !built; attempt++) {
+        map->seed = mix64(seed + (uint64_t)attempt * PILOT_MIX);
+        built = build_with_seed(keys, n, map->range, map->buckets, map->seed,
+                                map->pilots, order);
+    }
+    if (!built) {
+        free(order);
+        frozen_destroy(map);
+        return NULL;
+    }
+    
+    // Exactly as many holes below n as keys past n: pair them up in order
+    size_t hole = 0;
+    for (size_t s = n; s < map->range; s++) {
+        if (order[s] == SIZE_MAX) continue;  // Unused slot, remap[] stays 0
+        while (order[hole] != SIZE_MAX) hole++;
+        order[hole] = order[s];
+        map->remap[s - n] = (uint32_t)hole;
+    }
+    
+    // Lay the pairs out in slot order
+    for (size_t s = 0; s < n; s++) {
+        map->entries[s].key = keys[order[s]];
+        map->entries[s].value = values[order[s]];
+    }
+    free(order);
+    return map;
+}
+
+// Free all memory
+void frozen_destroy(FrozenMap *map) {
+    if (!map) return;
+    free(map->entries);  // Free entry array
+    free(map->pilots);   // Free pilot array
+    free(map->remap);    // Free remap array
+    free(map);           // Free main struct
+}
+
+// Retrieve value for a key
+// One pilot read, then one entry read that either holds the key or not
+bool frozen_get(const FrozenMap *map, int key, int *value) {
+    if (!map || map->size == 0) return false;
+    
+    uint64_t kh = key_hash(key, map->seed);
+    uint32_t pilot = map->pilots[bucket_of(kh, map->buckets)];
+    size_t slot = slot_of(kh, pilot, map->range);
+    if (slot >= map->size) slot = map->remap[slot - map->size];  // About 1%
+    const FrozenEntry *e = &map->entries[slot];
+    if (e->key != key) return false;  // Every slot is full: a miss is a mismatch
+    if (value) *value = e->value;
+    return true;
+}
+
+// Return number of stored elements
+size_t frozen_size(const FrozenMap *map) {
+    return map ? map->size : 0;
+}
+
+// Calculate total memory usage
+size_t frozen_memory_usage(const FrozenMap *map) {
+    if (!map) return 0;
+    // Main struct + one entry per key + one pilot per bucket + remap
+    return sizeof(FrozenMap) + map->size * sizeof(FrozenEntry) +
+           (map->buckets + map->range - map->size) * sizeof(uint32_t);
+}
@@ -0,0 +1,46 @@
+/*
+ * Frozen (Read-Only) Hash Map Header
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ */
+
+#ifndef FROZEN_H // Include guard
+#define FROZEN_H // Prevent multiple inclusions
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Average keys per bucket of the perfect hash (CHD lambda)
+// Larger buckets shrink the pilot array but lengthen the build
+#define FROZEN_BUCKET_SIZE 3
+
+// Fraction of the hash range filled by keys (PTHash alpha)
+// Slack makes the last buckets cheap to place; slots past n are remapped
+#define FROZEN_ALPHA 0.99
+
+// Entry structure, exactly one per key
+typedef struct {
+    int key;    // Key stored in slot
+    int value;  // Value associated with key
+} FrozenEntry;
+
+// Immutable map over a minimal perfect hash
+typedef struct {
+    FrozenEntry *entries; // Dense array of size slots, one per key
+    uint32_t *pilots;     // Displacement chosen for each bucket
+    uint32_t *remap;      // Entry for hash slots size .. range - 1
+    size_t size;          // Number of keys (and entries)
+    size_t range;         // Hash slots (size / FROZEN_ALPHA)
+    size_t buckets;       // Number of pilots
+    uint64_t seed;        // Seed of the key hash that succeeded
+} FrozenMap;
+
+FrozenMap* frozen_build(const int *keys, const int *values, size_t n, uint64_t seed); // Build from n distinct keys. Returns NULL on failure
+void frozen_destroy(FrozenMap *map); // Free the frozen map
+bool frozen_get(const FrozenMap *map, int key, int *value); // Retrieve value for key
+size_t frozen_size(const FrozenMap *map); // Get number of stored elements
+size_t frozen_memory_usage(const FrozenMap *map); // Get total memory usage in bytes
+
+#endif
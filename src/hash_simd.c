@@ -0,0 +1,143 @@
+/*
+ * Batched Hashing Implementation
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * fmix32 (Appleby, MurmurHash3) is only 32-bit xor, shift and multiply,
+ * so eight (AVX2) or sixteen (AVX-512) keys can be mixed with the same
+ * instruction sequence. The vector bodies are compiled with
+ * __attribute__((target)) so the rest of the program keeps the baseline
+ * -O2 flags, and the level is chosen at run time with
+ * __builtin_cpu_supports. Other compilers and CPUs use the scalar loop.
+ */
+
+#include "hash_simd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HASH_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// Scalar fmix32 with seed, identical to the maps' hash()
+static unsigned int fmix32(unsigned int k) {
+    k ^= (k >> 16);      // Mix high bits down
+    k *= 0x85ebca6b;     // Multiply by magic constant
+    k ^= (k >> 13);      // More mixing
+    k *= 0xc2b2ae35;     // Another constant
+    k ^= (k >> 16);      // Final mix
+    return k;
+}
+
+// One key at a time, also used for the tail of the vector paths
+static void hash_scalar(const int *keys, unsigned int seed, unsigned int *out,
+                        size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = fmix32((unsigned int)keys[i] ^ seed);
+    }
+}
+
+#ifdef HASH_SIMD_X86
+// Eight keys per iteration
+__attribute__((target("avx2")))
+static void hash_avx2(const int *keys, unsigned int seed, unsigned int *out,
+                      size_t n) {
+    const __m256i vseed = _mm256_set1_epi32((int)seed);
+    const __m256i c1 = _mm256_set1_epi32((int)0x85ebca6b);
+    const __m256i c2 = _mm256_set1_epi32((int)0xc2b2ae35);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i k = _mm256_loadu_si256((const __m256i *)(keys + i));
+        k = _mm256_xor_si256(k, vseed);
+        k = _mm256_xor_si256(k, _mm256_srli_epi32(k, 16));
+        k = _mm256_mullo_epi32(k, c1);
+        k = _mm256_xor_si256(k, _mm256_srli_epi32(k, 13));
+        k = _mm256_mullo_epi32(k, c2);
+        k = _mm256_xor_si256(k, _mm256_srli_epi32(k, 16));
+        _mm256_storeu_si256((__m256i *)(out + i), k);
+    }
+    hash_scalar(keys + i, seed, out + i, n - i);
+}
+
+// Sixteen keys per iteration
+__attribute__((target("avx512f")))
+static void hash_avx512(const int *keys, unsigned int seed, unsigned int *out,
+                        size_t n) {
+    const __m512i vseed = _mm512_set1_epi32((int)seed);
+    const __m512i c1 = _mm512_set1_epi32((int)0x85ebca6b);
+    const __m512i c2 = _mm512_set1_epi32((int)0xc2b2ae35);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i k = _mm512_loadu_si512((const void *)(keys + i));
+        k = _mm512_xor_si512(k, vseed);
+        k = _mm512_xor_si512(k, _mm512_srli_epi32(k, 16));
+        k = _mm512_mullo_epi32(k, c1);
+        k = _mm512_xor_si512(k, _mm512_srli_epi32(k, 13));
+        k = _mm512_mullo_epi32(k, c2);
+        k = _mm512_xor_si512(k, _mm512_srli_epi32(k, 16));
+        _mm512_storeu_si512((void *)(out + i), k);
+    }
+    hash_scalar(keys + i, seed, out + i, n - i);
+}
+#endif
+
+// Racing first calls to hash_simd_best (e.g. from resize threads) store
+// the same value; the accesses are atomic so that race is well defined
+#ifdef __GNUC__
+#define DETECTED_LOAD(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define DETECTED_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#else
+#define DETECTED_LOAD(p) (*(p))
+#define DETECTED_STORE(p, v) (*(p) = (v))
+#endif
+
+// Best level this CPU supports (detected once)
+HashSimdLevel hash_simd_best(void) {
+    static int detected = -1;
+    int seen = DETECTED_LOAD(&detected);
+    if (seen < 0) {
+        HashSimdLevel level = HASH_SIMD_SCALAR;
+#ifdef HASH_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            level = HASH_SIMD_AVX512;
+        } else if (__builtin_cpu_supports("avx2")) {
+            level = HASH_SIMD_AVX2;
+        }
+#endif
+        seen = (int)level;
+        DETECTED_STORE(&detected, seen);
+    }
+    return (HashSimdLevel)seen;
+}
+
+// Name of a level for reports
+const char* hash_simd_name(HashSimdLevel level) {
+    switch (level) {
+        case HASH_SIMD_AVX2:   return "avx2";
+        case HASH_SIMD_AVX512: return "avx512";
+        default:               return "scalar";
+    }
+}
+
+// Hash n keys at a given level, clamped to what the CPU supports
+void hash_batch_with(HashSimdLevel level, const int *keys, unsigned int seed,
+                     unsigned int *out, size_t n) {
+    if (level > hash_simd_best()) level = hash_simd_best();
+#ifdef HASH_SIMD_X86
+    if (level == HASH_SIMD_AVX512) {
+        hash_avx512(keys, seed, out, n);
+        return;
+    }
+    if (level == HASH_SIMD_AVX2) {
+        hash_avx2(keys, seed, out, n);
+        return;
+    }
+#endif
+    hash_scalar(keys, seed, out, n);
+}
+
+// Hash n keys using the best level
+void hash_batch(const int *keys, unsigned int seed, unsigned int *out, size_t n) {
+    hash_batch_with(hash_simd_best(), keys, seed, out, n);
+}
@@ -0,0 +1,37 @@
+/*
+ * Batched Hashing Header
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ */
+
+#ifndef HASH_SIMD_H // Include guard
+#define HASH_SIMD_H // Prevent multiple inclusions
+
+#include <stddef.h>
+
+// Keys hashed per call by the map batch paths (fits on the stack)
+#define HASH_BATCH 64
+
+// Instruction set used for a batch
+typedef enum {
+    HASH_SIMD_SCALAR = 0,  // One key at a time (always available)
+    HASH_SIMD_AVX2,        // 8 keys per vector
+    HASH_SIMD_AVX512       // 16 keys per vector
+} HashSimdLevel;
+
+// Best level this CPU supports (detected once)
+HashSimdLevel hash_simd_best(void);
+
+// Name of a level for reports ("scalar", "avx2", "avx512")
+const char* hash_simd_name(HashSimdLevel level);
+
+// out[i] = fmix32(keys[i] ^ seed) for i < n using the best level
+// This is the maps' hash() before the final % capacity
+void hash_batch(const int *keys, unsigned int seed, unsigned int *out, size_t n);
+
+// Same as hash_batch at a given level, clamped to what the CPU supports
+void hash_batch_with(HashSimdLevel level, const int *keys, unsigned int seed,
+                     unsigned int *out, size_t n);
+
+#endif
@@ -0,0 +1,28 @@
+/*
+ * Operational Statistics Header
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * Counters are compiled in only when HASHMAP_STATS is defined
+ * (make stats). Otherwise every STAT_* macro expands to nothing,
+ * the stats fields are left out of the map structs, and the
+ * *_stats() getters report that statistics are disabled.
+ */
+
+#ifndef HASHMAP_STATS_H // Include guard
+#define HASHMAP_STATS_H // Prevent multiple inclusions
+
+#ifdef HASHMAP_STATS
+#define STAT_ADD(map, field, n) ((map)->stats.field += (n))      // Add n to a counter
+#define STAT_MAX(map, field, v) \
+    do { if ((v) > (map)->stats.field) (map)->stats.field = (v); } while (0) // Track a maximum
+#else
+#define STAT_ADD(map, field, n) ((void)0)
+#define STAT_MAX(map, field, v) ((void)0)
+#endif
+
+#define STAT_INC(map, field) STAT_ADD(map, field, 1) // Increment a counter
+#define STAT_DEC(map, field) STAT_ADD(map, field, -1) // Decrement a counter
+
+#endif
@@ -0,0 +1,437 @@
+/*
+ * Type-Specialized Hash Map Templates
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * Header-only, macro-instantiated versions of the three maps for any key
+ * and value type. Each DEFINE_* macro expands to a struct and a set of
+ * static inline functions with the hash and equality functions named
+ * directly, so the compiler inlines them into every probe loop instead of
+ * calling through a pointer (the approach of klib's khash.h, Attractive
+ * Chaos 2008-2011, https://github.com/attractivechaos/klib).
+ *
+ * hash_fn: uint32_t hash_fn(K key, uint32_t seed), should mix all bits
+ * eq_fn:   bool eq_fn(K a, K b)
+ *
+ * Example:
+ *     DEFINE_LINEAR_MAP(IntMap, int, int, hashmap_int_hash, hashmap_int_eq)
+ *     IntMap *m = IntMap_create(1024);
+ *     IntMap_put(m, 7, 49);
+ *
+ * The algorithms match chained.c, linear_probing.c and cuckoo.c (seeded
+ * hashing, tombstones, cuckoo growth at load 0.45), without their option
+ * structs, statistics and flood detection.
+ */
+
+#ifndef HASHMAP_TEMPLATE_H // Include guard
+#define HASHMAP_TEMPLATE_H // Prevent multiple inclusions
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "prng.h"
+
+// Cuckoo template tuning, same values as cuckoo.c
+#define TEMPLATE_CUCKOO_MAX_DISPLACEMENTS 500
+#define TEMPLATE_CUCKOO_MAX_LOAD 0.45
+
+// MurmurHash3 fmix32 with seed, the hash used by the int maps
+static inline uint32_t hashmap_int_hash(int key, uint32_t seed) {
+    uint32_t k = (uint32_t)key ^ seed;
+    k ^= (k >> 16);
+    k *= 0x85ebca6bU;
+    k ^= (k >> 13);
+    k *= 0xc2b2ae35U;
+    k ^= (k >> 16);
+    return k;
+}
+
+// Equality for int keys
+static inline bool hashmap_int_eq(int a, int b) {
+    return a == b;
+}
+
+/* Separate chaining: array of singly linked lists, new keys at the head */
+#define DEFINE_CHAINED_MAP(name, K, V, hash_fn, eq_fn)                         \
+typedef struct name##_node {                                                   \
+    K key;                                                                     \
+    V value;                                                                   \
+    struct name##_node *next;                                                  \
+} name##_node;                                                                 \
+                                                                               \
+typedef struct {                                                               \
+    name##_node **buckets;  /* Chain heads */                                  \
+    size_t capacity;        /* Number of buckets */                            \
+    size_t size;            /* Stored pairs */                                 \
+    uint32_t seed;          /* Seed passed to hash_fn */                       \
+} name;                                                                        \
+                                                                               \
+static inline name* name##_create(size_t capacity) {                           \
+    name *map = malloc(sizeof(name));                                          \
+    if (!map) return NULL;                                                     \
+    if (capacity == 0) capacity = 1;                                           \
+    map->buckets = calloc(capacity, sizeof(name##_node*));                     \
+    if (!map->buckets) {                                                       \
+        free(map);                                                             \
+        return NULL;                                                           \
+    }                                                                          \
+    map->capacity = capacity;                                                  \
+    map->size = 0;                                                             \
+    map->seed = (uint32_t)prng_default_seed(map);                              \
+    return map;                                                                \
+}                                                                              \
+                                                                               \
+static inline void name##_destroy(name *map) {                                 \
+    if (!map) return;                                                          \
+    for (size_t i = 0; i < map->capacity; i++) {                               \
+        name##_node *node = map->buckets[i];                                   \
+        while (node) {                                                         \
+            name##_node *next = node->next;                                    \
+            free(node);                                                        \
+            node = next;                                                       \
+        }                                                                      \
+    }                                                                          \
+    free(map->buckets);                                                        \
+    free(map);                                                                 \
+}                                                                              \
+                                                                               \
+static inline bool name##_put(name *map, K key, V value) {                     \
+    if (!map) return false;                                                    \
+    size_t idx = hash_fn(key, map->seed) % map->capacity;                      \
+    for (name##_node *node = map->buckets[idx]; node; node = node->next) {     \
+        if (eq_fn(node->key, key)) {                                           \
+            node->value = value;                                               \
+            return true;                                                       \
+        }                                                                      \
+    }                                                                          \
+    name##_node *node = malloc(sizeof(name##_node));                           \
+    if (!node) return false;                                                   \
+    node->key = key;                                                           \
+    node->value = value;                                                       \
+    node->next = map->buckets[idx];                                            \
+    map->buckets[idx] = node;                                                  \
+    map->size++;                                                               \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+static inline bool name##_get(name *map, K key, V *value) {                    \
+    if (!map) return false;                                                    \
+    size_t idx = hash_fn(key, map->seed) % map->capacity;                      \
+    for (name##_node *node = map->buckets[idx]; node; node = node->next) {     \
+        if (eq_fn(node->key, key)) {                                           \
+            if (value) *value = node->value;                                   \
+            return true;                                                       \
+        }                                                                      \
+    }                                                                          \
+    return false;                                                              \
+}                                                                              \
+                                                                               \
+static inline bool name##_delete(name *map, K key) {                           \
+    if (!map) return false;                                                    \
+    size_t idx = hash_fn(key, map->seed) % map->capacity;                      \
+    name##_node **link = &map->buckets[idx];                                   \
+    for (; *link; link = &(*link)->next) {                                     \
+        if (eq_fn((*link)->key, key)) {                                        \
+            name##_node *node = *link;                                         \
+            *link = node->next;                                                \
+            free(node);                                                        \
+            map->size--;                                                       \
+            return true;                                                       \
+        }                                                                      \
+    }                                                                          \
+    return false;                                                              \
+}                                                                              \
+                                                                               \
+static inline size_t name##_size(name *map) {                                  \
+    return map ? map->size : 0;                                                \
+}                                                                              \
+                                                                               \
+static inline size_t name##_memory_usage(name *map) {                          \
+    if (!map) return 0;                                                        \
+    return sizeof(name) + map->capacity * sizeof(name##_node*) +               \
+           map->size * sizeof(name##_node);                                    \
+}
+
+/* Linear probing: flat array, tombstones on delete, no growth */
+#define DEFINE_LINEAR_MAP(name, K, V, hash_fn, eq_fn)                          \
+typedef struct {                                                               \
+    K key;                                                                     \
+    V value;                                                                   \
+    unsigned char state;    /* 0 empty, 1 occupied, 2 deleted */               \
+} name##_entry;                                                                \
+                                                                               \
+typedef struct {                                                               \
+    name##_entry *entries;  /* Slot array */                                   \
+    size_t capacity;        /* Number of slots */                              \
+    size_t size;            /* Occupied slots */                               \
+    uint32_t seed;          /* Seed passed to hash_fn */                       \
+} name;                                                                        \
+                                                                               \
+static inline name* name##_create(size_t capacity) {                           \
+    name *map = malloc(sizeof(name));                                          \
+    if (!map) return NULL;                                                     \
+    if (capacity == 0) capacity = 1;                                           \
+    map->entries = calloc(capacity, sizeof(name##_entry));                     \
+    if (!map->entries) {                                                       \
+        free(map);                                                             \
+        return NULL;                                                           \
+    }                                                                          \
+    map->capacity = capacity;                                                  \
+    map->size = 0;                                                             \
+    map->seed = (uint32_t)prng_default_seed(map);                              \
+    return map;                                                                \
+}                                                                              \
+                                                                               \
+static inline void name##_destroy(name *map) {                                 \
+    if (!map) return;                                                          \
+    free(map->entries);                                                        \
+    free(map);                                                                 \
+}                                                                              \
+                                                                               \
+static inline bool name##_put(name *map, K key, V value) {                     \
+    if (!map) return false;                                                    \
+    size_t idx = hash_fn(key, map->seed) % map->capacity;                      \
+    name##_entry *slot = NULL;  /* First free slot on the probe path */        \
+    /* The key may sit past a tombstone: probe on to it or to EMPTY */         \
+    for (size_t n = 0; n < map->capacity; n++) {                               \
+        name##_entry *e = &map->entries[idx];                                  \
+        if (e->state == 0) {                                                   \
+            if (!slot) slot = e;                                               \
+            break;                                                             \
+        }                                                                      \
+        if (e->state == 2) {                                                   \
+            if (!slot) slot = e;                                               \
+        } else if (eq_fn(e->key, key)) {                                       \
+            e->value = value;                                                  \
+            return true;                                                       \
+        }                                                                      \
+        if (++idx == map->capacity) idx = 0;                                   \
+    }                                                                          \
+    if (!slot) return false;  /* Full */                                       \
+    slot->key = key;                                                           \
+    slot->value = value;                                                       \
+    slot->state = 1;                                                           \
+    map->size++;                                                               \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+static inline bool name##_get(name *map, K key, V *value) {                    \
+    if (!map) return false;                                                    \
+    size_t idx = hash_fn(key, map->seed) % map->capacity;                      \
+    for (size_t n = 0; n < map->capacity; n++) {                               \
+        name##_entry *e = &map->entries[idx];                                  \
+        if (e->state == 0) return false;                                       \
+        if (e->state == 1 && eq_fn(e->key, key)) {                             \
+            if (value) *value = e->value;                                      \
+            return true;                                                       \
+        }                                                                      \
+        if (++idx == map->capacity) idx = 0;                                   \
+    }                                                                          \
+    return false;                                                              \
+}                                                                              \
+                                                                               \
+static inline bool name##_delete(name *map, K key) {                           \
+    if (!map) return false;                                                    \
+    size_t idx = hash_fn(key, map->seed) % map->capacity;                      \
+    for (size_t n = 0; n < map->capacity; n++) {                               \
+        name##_entry *e = &map->entries[idx];                                  \
+        if (e->state == 0) return false;                                       \
+        if (e->state == 1 && eq_fn(e->key, key)) {                             \
+            e->state = 2;                                                      \
+            map->size--;                                                       \
+            return true;                                                       \
+        }                                                                      \
+        if (++idx == map->capacity) idx = 0;                                   \
+    }                                                                          \
+    return false;                                                              \
+}                                                                              \
+                                                                               \
+static inline size_t name##_size(name *map) {                                  \
+    return map ? map->size : 0;                                                \
+}                                                                              \
+                                                                               \
+static inline size_t name##_memory_usage(name *map) {                          \
+    if (!map) return 0;                                                        \
+    return sizeof(name) + map->capacity * sizeof(name##_entry);                \
+}
+
+/* Cuckoo hashing: two tables, grows past TEMPLATE_CUCKOO_MAX_LOAD and     */
+/* rebuilds with new seeds (doubling if needed) when a chain fails          */
+#define DEFINE_CUCKOO_MAP(name, K, V, hash_fn, eq_fn)                          \
+typedef struct {                                                               \
+    K key;                                                                     \
+    V value;                                                                   \
+    bool occupied;                                                             \
+} name##_entry;                                                                \
+                                                                               \
+typedef struct {                                                               \
+    name##_entry *tables[2]; /* One table per hash function */                 \
+    size_t capacity;         /* Slots in EACH table */                         \
+    size_t size;             /* Stored pairs */                                \
+    uint32_t seeds[2];       /* Seeds passed to hash_fn */                     \
+    int rehash_count;        /* Rebuilds after a failed chain */               \
+    Prng rng;                /* Source of new seeds */                         \
+} name;                                                                        \
+                                                                               \
+static inline void name##_new_seeds(name *map) {                               \
+    map->seeds[0] = (uint32_t)prng_next(&map->rng);                            \
+    do {                                                                       \
+        map->seeds[1] = (uint32_t)prng_next(&map->rng);                        \
+    } while (map->seeds[1] == map->seeds[0]);                                  \
+}                                                                              \
+                                                                               \
+static inline name* name##_create(size_t capacity) {                           \
+    name *map = malloc(sizeof(name));                                          \
+    if (!map) return NULL;                                                     \
+    if (capacity == 0) capacity = 1;                                           \
+    map->tables[0] = calloc(capacity, sizeof(name##_entry));                   \
+    map->tables[1] = calloc(capacity, sizeof(name##_entry));                   \
+    if (!map->tables[0] || !map->tables[1]) {                                  \
+        free(map->tables[0]);                                                  \
+        free(map->tables[1]);                                                  \
+        free(map);                                                             \
+        return NULL;                                                           \
+    }                                                                          \
+    map->capacity = capacity;                                                  \
+    map->size = 0;                                                             \
+    map->rehash_count = 0;                                                     \
+    prng_seed(&map->rng, prng_default_seed(map));                              \
+    name##_new_seeds(map);                                                     \
+    return map;                                                                \
+}                                                                              \
+                                                                               \
+static inline void name##_destroy(name *map) {                                 \
+    if (!map) return;                                                          \
+    free(map->tables[0]);                                                      \
+    free(map->tables[1]);                                                      \
+    free(map);                                                                 \
+}                                                                              \
+                                                                               \
+/* Place a key known to be absent. On failure the key and value  */         \
+/* pointers hold the homeless pair so the caller can rebuild and retry */     \
+static inline bool name##_place(name *map, K *key, V *value) {                 \
+    int t = 0;                                                                 \
+    for (int i = 0; i < TEMPLATE_CUCKOO_MAX_DISPLACEMENTS; i++) {              \
+        size_t idx = hash_fn(*key, map->seeds[t]) % map->capacity;             \
+        name##_entry *e = &map->tables[t][idx];                                \
+        if (!e->occupied) {                                                    \
+            e->key = *key;                                                     \
+            e->value = *value;                                                 \
+            e->occupied = true;                                                \
+            map->size++;                                                       \
+            return true;                                                       \
+        }                                                                      \
+        K evicted_key = e->key;                                                \
+        V evicted_value = e->value;                                            \
+        e->key = *key;                                                         \
+        e->value = *value;                                                     \
+        *key = evicted_key;                                                    \
+        *value = evicted_value;                                                \
+        t ^= 1;  /* The evicted key tries its other table */                   \
+    }                                                                          \
+    return false;                                                              \
+}                                                                              \
+                                                                               \
+/* Move every pair into fresh tables under new seeds, doubling the */         \
+/* capacity until everything fits. The old tables go once it does */          \
+static inline bool name##_rebuild(name *map, size_t new_capacity) {            \
+    name##_entry *old[2] = {map->tables[0], map->tables[1]};                   \
+    size_t old_capacity = map->capacity;                                       \
+    size_t old_size = map->size;                                               \
+    for (;;) {                                                                 \
+        map->tables[0] = calloc(new_capacity, sizeof(name##_entry));           \
+        map->tables[1] = calloc(new_capacity, sizeof(name##_entry));           \
+        if (!map->tables[0] || !map->tables[1]) {                              \
+            free(map->tables[0]);                                              \
+            free(map->tables[1]);                                              \
+            break;                                                             \
+        }                                                                      \
+        map->capacity = new_capacity;                                          \
+        map->size = 0;                                                         \
+        name##_new_seeds(map);                                                 \
+        bool ok = true;                                                        \
+        for (int t = 0; t < 2 && ok; t++) {                                    \
+            for (size_t i = 0; i < old_capacity && ok; i++) {                  \
+                if (!old[t][i].occupied) continue;                             \
+                K key = old[t][i].key;                                         \
+                V value = old[t][i].value;                                     \
+                ok = name##_place(map, &key, &value);                          \
+            }                                                                  \
+        }                                                                      \
+        if (ok) {                                                              \
+            free(old[0]);                                                      \
+            free(old[1]);                                                      \
+            return true;                                                       \
+        }                                                                      \
+        free(map->tables[0]);                                                  \
+        free(map->tables[1]);                                                  \
+        new_capacity *= 2;                                                     \
+    }                                                                          \
+    map->tables[0] = old[0];                                                   \
+    map->tables[1] = old[1];                                                   \
+    map->capacity = old_capacity;                                              \
+    map->size = old_size;                                                      \
+    return false;                                                              \
+}                                                                              \
+                                                                               \
+static inline bool name##_get(name *map, K key, V *value) {                    \
+    if (!map) return false;                                                    \
+    for (int t = 0; t < 2; t++) {                                              \
+        size_t idx = hash_fn(key, map->seeds[t]) % map->capacity;              \
+        name##_entry *e = &map->tables[t][idx];                                \
+        if (e->occupied && eq_fn(e->key, key)) {                               \
+            if (value) *value = e->value;                                      \
+            return true;                                                       \
+        }                                                                      \
+    }                                                                          \
+    return false;                                                              \
+}                                                                              \
+                                                                               \
+static inline bool name##_put(name *map, K key, V value) {                     \
+    if (!map) return false;                                                    \
+    for (int t = 0; t < 2; t++) {                                              \
+        size_t idx = hash_fn(key, map->seeds[t]) % map->capacity;              \
+        name##_entry *e = &map->tables[t][idx];                                \
+        if (e->occupied && eq_fn(e->key, key)) {                               \
+            e->value = value;                                                  \
+            return true;                                                       \
+        }                                                                      \
+    }                                                                          \
+    if ((double)(map->size + 1) / (2.0 * map->capacity) >                     \
+        TEMPLATE_CUCKOO_MAX_LOAD) {                                            \
+        name##_rebuild(map, map->capacity * 2);                                \
+    }                                                                          \
+    while (!name##_place(map, &key, &value)) {                                 \
+        /* key/value now hold whichever pair was left homeless */              \
+        map->rehash_count++;                                                   \
+        if (!name##_rebuild(map, map->capacity)) return false;                 \
+    }                                                                          \
+    return true;                                                               \
+}                                                                              \
+                                                                               \
+static inline bool name##_delete(name *map, K key) {                           \
+    if (!map) return false;                                                    \
+    for (int t = 0; t < 2; t++) {                                              \
+        size_t idx = hash_fn(key, map->seeds[t]) % map->capacity;              \
+        name##_entry *e = &map->tables[t][idx];                                \
+        if (e->occupied && eq_fn(e->key, key)) {                               \
+            e->occupied = false;                                               \
+            map->size--;                                                       \
+            return true;                                                       \
+        }                                                                      \
+    }                                                                          \
+    return false;                                                              \
+}                                                                              \
+                                                                               \
+static inline size_t name##_size(name *map) {                                  \
+    return map ? map->size : 0;                                                \
+}                                                                              \
+                                                                               \
+static inline size_t name##_memory_usage(name *map) {                          \
+    if (!map) return 0;                                                        \
+    return sizeof(name) + 2 * map->capacity * sizeof(name##_entry);            \
+}
+
+#endif
@@ -0,0 +1,44 @@
+/*
+ * Entry Expiration (TTL) Header
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * Expiry timestamps are compiled in only when HASHMAP_TTL is defined
+ * (make ttl), so plain builds keep their entry sizes. Each map keeps its
+ * own clock, advanced by *_set_time in whatever unit the caller uses.
+ * An entry put with *_put_ttl expires once the clock reaches its
+ * deadline: lookups treat it as a miss and reclaim it on the spot, and
+ * *_expire_step reclaims the rest a bounded number of slots at a time.
+ * Without HASHMAP_TTL the TTL_* macros expand to nothing and the *_ttl
+ * functions report that expiry is disabled.
+ */
+
+#ifndef HASHMAP_TTL_H // Include guard
+#define HASHMAP_TTL_H // Prevent multiple inclusions
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Deadline of an entry that never expires
+#define TTL_NEVER 0
+
+#ifdef HASHMAP_TTL
+#define TTL_EXPIRED(map, e) \
+    ((e)->expires != TTL_NEVER && (e)->expires <= (map)->now) // Entry past its deadline
+#define TTL_SET(e, deadline) ((e)->expires = (deadline))      // Set an entry's deadline
+#define TTL_GET(e) ((e)->expires)                              // An entry's deadline
+#else
+#define TTL_EXPIRED(map, e) false
+#define TTL_SET(e, deadline) ((void)(deadline))
+#define TTL_GET(e) TTL_NEVER
+#endif
+
+// Deadline of an entry put at time now with a time-to-live of ttl
+// A ttl of 0 never expires, and deadlines saturate instead of wrapping
+static inline uint64_t ttl_deadline(uint64_t now, uint64_t ttl) {
+    if (ttl == 0) return TTL_NEVER;
+    return now > UINT64_MAX - ttl ? UINT64_MAX : now + ttl;
+}
+
+#endif
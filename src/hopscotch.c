@@ -0,0 +1,287 @@
+/*
+ * Hopscotch Hash Map Implementation
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * Hopscotch Hash Map Implementation is based on: Herlihy, M., Shavit, N., &
+ * Tzafrir, M. (2008). Hopscotch hashing. In Distributed Computing (DISC 2008),
+ * LNCS 5218, 350-364.
+ * Like linear probing, keys live in one flat array near their home slot,
+ * but every key is kept within HOPSCOTCH_NEIGHBORHOOD slots of home. Each home bucket
+ * carries a bitmap of which neighborhood slots hold its keys, so a lookup
+ * reads at most H slots (usually one or two cache lines) and a miss never
+ * scans a cluster. When a free slot is too far away, closer keys are
+ * "hopped" into it; when that is impossible the table grows.
+ */
+
+#include "hopscotch.h"
+#include <stdlib.h>
+
+// How far insertion searches for a free slot before growing the table
+#define ADD_RANGE 512
+
+/* Hash function using MurmurHash-inspired bit mixing
+* Code adapted from Appleby, A. (2011). MurmurHash3 fmix32() finalizer.
+* Retrieved from https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp.
+* The bit-mixing sequence and associated constants in the hash_with_seed function
+* were adapted from the fmix32() finalizer of MurmurHash3.
+*/
+static size_t hash(int key, size_t capacity) {
+    unsigned int k = (unsigned int)key;
+    k ^= (k >> 16);      // Mix high bits down
+    k *= 0x85ebca6b;     // Multiply by magic constant
+    k ^= (k >> 13);      // More mixing
+    k *= 0xc2b2ae35;     // Another constant
+    k ^= (k >> 16);      // Final mix
+    return k % capacity; // Reduce to valid index
+}
+
+// Index of the lowest set bit of a non-zero bitmap
+static int lowest_bit(uint32_t bits) {
+#ifdef __GNUC__
+    return __builtin_ctz(bits);
+#else
+    int i = 0;
+    while (!(bits & 1u)) {
+        bits >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+// Slot that lies offset positions after idx, wrapping around the table
+static size_t wrap(HopscotchHashMap *map, size_t idx, size_t offset) {
+    idx += offset;
+    return idx >= map->capacity ? idx - map->capacity : idx;
+}
+
+// Create a new hopscotch hash map
+HopscotchHashMap* hopscotch_create(size_t capacity) {
+    // Allocate main structure
+    HopscotchHashMap *map = malloc(sizeof(HopscotchHashMap));
+    if (!map) return NULL;
+
+    // At least one full neighborhood so offsets never alias
+    if (capacity < HOPSCOTCH_NEIGHBORHOOD) capacity = HOPSCOTCH_NEIGHBORHOOD;
+
+    // Allocate bucket array (zeroed: empty slots, empty bitmaps)
+    map->buckets = calloc(capacity, sizeof(HopscotchBucket));
+    if (!map->buckets) {
+        free(map);
+        return NULL;
+    }
+
+    map->capacity = capacity;
+    map->size = 0;
+    map->resize_count = 0;
+    return map;
+}
+
+// Free all memory
+void hopscotch_destroy(HopscotchHashMap *map) {
+    if (!map) return;
+    free(map->buckets);  // Free bucket array
+    free(map);           // Free main struct
+}
+
+// Locate key through its home bitmap
+// Returns the slot index, or capacity if the key is absent
+// probes (may be NULL) receives the number of slots inspected
+static size_t find_slot(HopscotchHashMap *map, int key, size_t *home_out,
+                        int *probes) {
+    size_t home = hash(key, map->capacity);
+    uint32_t hop = map->buckets[home].hop_info;
+    int inspected = 1;  // The home bucket itself
+
+    if (home_out) *home_out = home;
+    // Only slots whose bit is set can hold this key
+    while (hop) {
+        size_t idx = wrap(map, home, (size_t)lowest_bit(hop));
+        if (idx != home) inspected++;
+        if (map->buckets[idx].occupied && map->buckets[idx].key == key) {
+            if (probes) *probes = inspected;
+            return idx;
+        }
+        hop &= hop - 1;  // Clear lowest bit, next candidate
+    }
+    if (probes) *probes = inspected;
+    return map->capacity;  // Not in the neighborhood
+}
+
+// Move the free slot at *free_idx (dist slots from its target home) closer
+// Looks for a key homed at most H - 1 slots before the free slot that can
+// legally move into it, starting with the farthest home to hop the most
+static bool hop_closer(HopscotchHashMap *map, size_t *free_idx, size_t *dist) {
+    size_t cap = map->capacity;
+    for (size_t j = HOPSCOTCH_NEIGHBORHOOD - 1; j > 0; j--) {
+        size_t home = (*free_idx + cap - j) % cap;  // Free slot is home + j
+        uint32_t hop = map->buckets[home].hop_info;
+        if (!hop) continue;
+
+        // Earliest key of this home that sits before the free slot
+        size_t i = (size_t)lowest_bit(hop);
+        if (i >= j) continue;
+
+        // Move it into the free slot, still inside home's neighborhood
+        size_t from = wrap(map, home, i);
+        HopscotchBucket *dst = &map->buckets[*free_idx];
+        dst->key = map->buckets[from].key;
+        dst->value = map->buckets[from].value;
+        dst->occupied = true;
+        map->buckets[from].occupied = false;
+        map->buckets[home].hop_info = (hop & ~(1u << i)) | (1u << j);
+
+        // The vacated slot is the new free slot
+        *free_idx = from;
+        *dist -= j - i;
+        return true;
+    }
+    return false;  // Nothing can move, neighborhood is saturated
+}
+
+// Insert a key known to be absent
+// Returns false if no free slot can be brought into its neighborhood
+static bool hopscotch_insert_internal(HopscotchHashMap *map, int key, int value) {
+    size_t cap = map->capacity;
+    if (map->size >= cap) return false;  // Full
+
+    size_t home = hash(key, cap);
+    size_t range = cap < ADD_RANGE ? cap : ADD_RANGE;
+
+    // Linear probe for the nearest free slot
+    size_t dist = 0;
+    while (dist < range && map->buckets[wrap(map, home, dist)].occupied) {
+        dist++;
+    }
+    if (dist == range) return false;
+
+    // Hop the free slot back until it is inside the neighborhood
+    size_t free_idx = wrap(map, home, dist);
+    while (dist >= HOPSCOTCH_NEIGHBORHOOD) {
+        if (!hop_closer(map, &free_idx, &dist)) return false;
+    }
+
+    HopscotchBucket *b = &map->buckets[free_idx];
+    b->key = key;
+    b->value = value;
+    b->occupied = true;
+    map->buckets[home].hop_info |= 1u << dist;
+    map->size++;
+    return true;
+}
+
+// Grow to new_capacity and reinsert every key
+// Doubles again in the rare case a neighborhood overflows during reinsertion
+static bool hopscotch_resize(HopscotchHashMap *map, size_t new_capacity) {
+    HopscotchBucket *old_buckets = map->buckets;
+    size_t old_capacity = map->capacity;
+    size_t old_size = map->size;
+
+    while (true) {
+        map->buckets = calloc(new_capacity, sizeof(HopscotchBucket));
+        if (!map->buckets) break;  // Out of memory
+        map->capacity = new_capacity;
+        map->size = 0;
+
+        bool success = true;
+        for (size_t i = 0; i < old_capacity && success; i++) {
+            if (old_buckets[i].occupied) {
+                success = hopscotch_insert_internal(map, old_buckets[i].key,
+                                                    old_buckets[i].value);
+            }
+        }
+        if (success) {
+            free(old_buckets);
+            map->resize_count++;
+            return true;
+        }
+        free(map->buckets);
+        new_capacity *= 2;
+    }
+
+    // Restore old state
+    map->buckets = old_buckets;
+    map->capacity = old_capacity;
+    map->size = old_size;
+    return false;
+}
+
+// Insert or update a key-value pair
+bool hopscotch_put(HopscotchHashMap *map, int key, int value) {
+    if (!map) return false;
+
+    // Found existing key
+    // Update value
+    size_t idx = find_slot(map, key, NULL, NULL);
+    if (idx < map->capacity) {
+        map->buckets[idx].value = value;
+        return true;  // No size change, just update
+    }
+
+    // Grow until the key fits within its neighborhood
+    while (!hopscotch_insert_internal(map, key, value)) {
+        if (!hopscotch_resize(map, map->capacity * 2)) return false;
+    }
+    return true;
+}
+
+// Retrieve value for a key
+// Reads at most HOPSCOTCH_NEIGHBORHOOD slots
+bool hopscotch_get(HopscotchHashMap *map, int key, int *value) {
+    if (!map) return false;
+
+    size_t idx = find_slot(map, key, NULL, NULL);
+    if (idx == map->capacity) return false;  // Not found
+    if (value) *value = map->buckets[idx].value;
+    return true;
+}
+
+// Delete a key
+// No tombstones: clearing the slot and its bitmap bit is enough
+bool hopscotch_delete(HopscotchHashMap *map, int key) {
+    if (!map) return false;
+
+    size_t home;
+    size_t idx = find_slot(map, key, &home, NULL);
+    if (idx == map->capacity) return false;  // Key not found
+
+    size_t offset = (idx + map->capacity - home) % map->capacity;
+    map->buckets[idx].occupied = false;
+    map->buckets[home].hop_info &= ~(1u << offset);
+    map->size--;
+    return true;
+}
+
+// Return number of stored elements
+size_t hopscotch_size(HopscotchHashMap *map) {
+    return map ? map->size : 0;
+}
+
+// Calculate total memory usage
+size_t hopscotch_memory_usage(HopscotchHashMap *map) {
+    if (!map) return 0;
+    // Main struct + all buckets (bitmaps live inside the buckets)
+    return sizeof(HopscotchHashMap) + map->capacity * sizeof(HopscotchBucket);
+}
+
+// Count slots inspected to find or determine absence of key
+// Never more than HOPSCOTCH_NEIGHBORHOOD
+int hopscotch_probe_count(HopscotchHashMap *map, int key) {
+    if (!map) return 0;
+    int probes = 0;
+    find_slot(map, key, NULL, &probes);
+    return probes;
+}
+
+// Return number of resizes performed
+int hopscotch_resize_count(HopscotchHashMap *map) {
+    return map ? map->resize_count : 0;
+}
+
+// Calculate current load factor
+double hopscotch_load_factor(HopscotchHashMap *map) {
+    if (!map || map->capacity == 0) return 0.0;
+    return (double)map->size / map->capacity;
+}
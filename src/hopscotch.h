@@ -0,0 +1,45 @@
+/*
+ * Hopscotch Hash Map Header
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ */
+
+#ifndef HOPSCOTCH_H // Include guard
+#define HOPSCOTCH_H // Prevent multiple inclusions
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Neighborhood size H: every key lives within H slots of its home bucket
+#define HOPSCOTCH_NEIGHBORHOOD 32
+
+// Bucket structure, one per slot
+typedef struct {
+    uint32_t hop_info; // Bit i set: slot home + i holds a key homed here
+    int key;           // Key stored in slot
+    int value;         // Value associated with key
+    bool occupied;     // Whether the slot holds a key
+} HopscotchBucket;
+
+// Main hash map structure
+typedef struct {
+    HopscotchBucket *buckets; // Array of buckets
+    size_t capacity;          // Total number of slots
+    size_t size;              // Number of occupied slots
+    int resize_count;         // Times the table grew to restore the invariant
+} HopscotchHashMap;
+
+HopscotchHashMap* hopscotch_create(size_t capacity); // Create a new hopscotch hash map
+void hopscotch_destroy(HopscotchHashMap *map); // Destroy the hash map and free memory
+bool hopscotch_put(HopscotchHashMap *map, int key, int value); // Insert or update a key value pair
+bool hopscotch_get(HopscotchHashMap *map, int key, int *value); // Retrieve value for key value pair
+bool hopscotch_delete(HopscotchHashMap *map, int key); // Delete a key value pair
+size_t hopscotch_size(HopscotchHashMap *map); // Get number of stored elements
+size_t hopscotch_memory_usage(HopscotchHashMap *map); // Get total memory usage in bytes
+int hopscotch_probe_count(HopscotchHashMap *map, int key); // Count slots inspected to find or miss a key
+int hopscotch_resize_count(HopscotchHashMap *map); // Get number of resizes
+double hopscotch_load_factor(HopscotchHashMap *map); // Get current load factor
+
+#endif
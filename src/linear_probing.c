@@ -3,10 +3,30 @@
  * Name: Siddharth Kakked
  * Semester: Fall 2025
  * Class: CS 5008
+ *
+ * Collisions follow a linear, quadratic (triangular) or double hashing
+ * probe sequence. The last two need a power-of-two capacity to reach
+ * every slot, so those maps round their capacity up.
+ *
+ * Keys are hashed with a per-map random seed. An insert that needs far
+ * more probes than the load explains is treated as hash flooding: the map
+ * draws a new seed and rebuilds the table at the same capacity, which also
+ * drops every tombstone.
+ *
+ * Built with HASHMAP_TTL, every entry carries a deadline. An expired entry
+ * is removed (tombstoned, or shifted out in cache mode) by the first
+ * lookup that reaches it, and linear_expire_step sweeps a few slots per
+ * call for entries nobody asks for again.
  */
 
+#define _POSIX_C_SOURCE 200112L // clock_gettime
+
 #include "linear_probing.h"
+#include "hash_simd.h"
+#include "parallel.h"
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 /* Hash function using MurmurHash-inspired bit mixing
 * Code adapted from Appleby, A. (2011). MurmurHash3 fmix32() finalizer. 
@@ -14,8 +34,9 @@
 * The bit-mixing sequence and associated constants in the hash_with_seed function 
 * were adapted from the fmix32() finalizer of MurmurHash3.
 */
-static size_t hash(int key, size_t capacity) {
+static size_t hash(int key, unsigned int seed, size_t capacity) {
     unsigned int k = (unsigned int)key;
+    k ^= seed;           // Mix in the per-map seed
     k ^= (k >> 16);      // Mix high bits down
     k *= 0x85ebca6b;     // Multiply by magic constant
     k ^= (k >> 13);      // More mixing
@@ -24,104 +45,671 @@ static size_t hash(int key, size_t capacity) {
     return k % capacity; // Reduce to valid index
 }
 
+// Salt for the second hash that gives the double hashing step
+#define DOUBLE_HASH_SALT 0x9e3779b9u
+
+// Smallest power of two that is at least n
+static size_t round_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+// Probe step for key: a second hash of the key for double hashing, forced
+// odd so it is coprime with the power-of-two capacity. 1 otherwise
+static size_t probe_step(LinearHashMap *map, int key) {
+    if (map->probe != PROBE_DOUBLE) return 1;
+    return hash(key, map->seed ^ DOUBLE_HASH_SALT, map->capacity) | 1;
+}
+
+// Slot that follows idx in a probe sequence after probes slots were read
+// Quadratic offsets grow by one per probe (0, 1, 3, 6, ...), which visits
+// every slot of a power-of-two table before repeating
+static size_t next_slot(LinearHashMap *map, size_t idx, size_t probes,
+                        size_t step) {
+    switch (map->probe) {
+        case PROBE_QUADRATIC: return (idx + probes) & (map->capacity - 1);
+        case PROBE_DOUBLE:    return (idx + step) & (map->capacity - 1);
+        default:              return idx + 1 == map->capacity ? 0 : idx + 1;
+    }
+}
+
+// Greatest common divisor, for the CLOCK stride
+static size_t gcd(size_t a, size_t b) {
+    while (b) {
+        size_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
 // Create a new linear probing hash map
 LinearHashMap* linear_create(size_t capacity) {
+    return linear_create_with(capacity, NULL);
+}
+
+// Create a new linear probing hash map with creation options
+LinearHashMap* linear_create_with(size_t capacity, const LinearOptions *opts) {
     // Allocate main structure
     LinearHashMap *map = malloc(sizeof(LinearHashMap));
     if (!map) return NULL;
     
-    // Allocate entry array
-    map->entries = calloc(capacity, sizeof(LinearEntry));
+    // Remember how entries were allocated so destroy can match it
+    memset(&map->alloc, 0, sizeof(map->alloc));
+    if (opts) map->alloc = opts->alloc;
+    
+    // Backward shift deletion in cache mode assumes linear probing
+    map->probe = opts ? opts->probe : PROBE_LINEAR;
+    if (opts && opts->cache != CACHE_NONE) map->probe = PROBE_LINEAR;
+    if (map->probe != PROBE_LINEAR) capacity = round_pow2(capacity);
+    
+    // Allocate entry array (zeroed)
+    map->entries = table_alloc(capacity * sizeof(LinearEntry), &map->alloc);
     if (!map->entries) {
         free(map);
         return NULL;
     }
     
-    // Initialize all slots as EMPTY
-    for (size_t i = 0; i < capacity; i++) {
-        map->entries[i].state = EMPTY;
+    // No per-slot initialization: EMPTY is 0 and the table arrives zeroed,
+    // so large tables are only paged in as slots are used
+    
+    // Cache mode: fixed table, an access word per slot, evict past the limit
+    map->cache = opts ? opts->cache : CACHE_NONE;
+    map->access = NULL;
+    if (map->cache != CACHE_NONE) {
+        map->access = calloc(capacity, sizeof(uint32_t));
+        if (!map->access) {
+            table_free(map->entries, capacity * sizeof(LinearEntry), &map->alloc);
+            free(map);
+            return NULL;
+        }
+    }
+    map->cache_limit = (size_t)(capacity * LINEAR_CACHE_MAX_LOAD);
+    if (map->cache_limit == 0) map->cache_limit = 1;
+    map->clock_hand = 0;
+    map->tick = 0;
+    map->evictions = 0;
+    // A hand moving one slot at a time would evict a whole region, leaving
+    // it empty and the rest of the table dense enough to form long
+    // clusters. Stepping by about 0.618 * capacity, coprime so one round
+    // still visits every slot, spreads evictions over the table
+    map->clock_stride = (size_t)(capacity * 0.6180339887) | 1;
+    while (capacity > 1 && gcd(map->clock_stride, capacity) != 1) {
+        map->clock_stride++;
     }
+    if (capacity > 0) map->clock_stride %= capacity;
+    if (map->clock_stride == 0) map->clock_stride = 1;
     
     map->capacity = capacity;
     map->size = 0;
+    map->max_probes = (opts && opts->max_probes) ? opts->max_probes
+                                                 : LINEAR_FLOOD_PROBES;
+    map->resize_threads = opts ? opts->resize_threads : 0;
+    map->reseed_guard = 0;
+    map->reseed_count = 0;
+#ifdef HASHMAP_STATS
+    memset(&map->stats, 0, sizeof(map->stats));  // Counters start at zero
+#endif
+#ifdef HASHMAP_TTL
+    map->now = 0;
+    map->sweep_cursor = 0;
+#endif
+    
+    // Per-map generator: reproducible when the caller passes a seed
+    uint64_t seed = (opts && opts->seed) ? opts->seed : prng_default_seed(map);
+    prng_seed(&map->rng, seed);
+    map->seed = (unsigned int)prng_next(&map->rng);
     return map;
 }
 
 // Free all memory
 void linear_destroy(LinearHashMap *map) {
     if (!map) return;
-    free(map->entries);  // Free entry array
+    table_free(map->entries, map->capacity * sizeof(LinearEntry), &map->alloc);
+    free(map->access);   // Cache mode access words (NULL otherwise)
     free(map);           // Free main struct
 }
 
-// Insert or update a key-value pair
-bool linear_put(LinearHashMap *map, int key, int value) {
-    if (!map || map->size >= map->capacity) return false;  // Full or NULL
+// Remove every entry but keep the table for reuse
+void linear_clear(LinearHashMap *map) {
+    if (!map) return;
+    map->entries = table_reset(map->entries, map->capacity * sizeof(LinearEntry),
+                               &map->alloc);
+    map->size = 0;
+    map->reseed_guard = 0;
+    if (map->access) {
+        memset(map->access, 0, map->capacity * sizeof(uint32_t));
+        map->clock_hand = 0;
+    }
+#ifdef HASHMAP_STATS
+    map->stats.tombstones = 0;  // Tombstones were wiped with the entries
+#endif
+#ifdef HASHMAP_TTL
+    map->sweep_cursor = 0;
+#endif
+}
+
+// Shared state of one table migration
+typedef struct {
+    LinearHashMap *map;          // Already switched to the new capacity and seed
+    const LinearEntry *old;      // Entries being moved
+    const uint32_t *old_access;  // Their access words (cache mode only)
+    LinearEntry *fresh;          // Destination table
+    uint32_t *fresh_access;      // Destination access words (cache mode only)
+    size_t dropped;              // Expired entries not carried over
+} LinearMigration;
+
+// Move old slots [begin, end) one HASH_BATCH of live keys at a time
+// Keys are distinct, so each goes to the first EMPTY slot of its sequence
+static void linear_migrate_serial(void *ctx, size_t begin, size_t end) {
+    LinearMigration *m = ctx;
+    LinearHashMap *map = m->map;
+    size_t i = begin;
+    while (i < end) {
+        const LinearEntry *batch[HASH_BATCH];
+        int keys[HASH_BATCH];
+        unsigned int h[HASH_BATCH];
+        size_t count = 0;
+        for (; i < end && count < HASH_BATCH; i++) {
+            if (m->old[i].state != OCCUPIED) continue;
+            if (TTL_EXPIRED(map, &m->old[i])) {
+                m->dropped++;  // Expired entries are not carried over
+                continue;
+            }
+            batch[count] = &m->old[i];
+            keys[count++] = m->old[i].key;
+        }
+        hash_batch(keys, map->seed, h, count);
+        for (size_t b = 0; b < count; b++) {
+            size_t idx = h[b] % map->capacity;
+            size_t step = probe_step(map, keys[b]);
+            for (size_t probes = 1; m->fresh[idx].state != EMPTY; probes++) {
+                idx = next_slot(map, idx, probes, step);
+            }
+            m->fresh[idx] = *batch[b];
+            if (m->fresh_access) {
+                m->fresh_access[idx] = m->old_access[batch[b] - m->old];
+            }
+        }
+    }
+}
+
+#ifdef PARALLEL_ATOMICS
+// Same as linear_migrate_serial, run by several threads at once: a slot is
+// claimed by switching it from EMPTY to OCCUPIED with compare-and-swap,
+// and only its claimer writes the key. Other threads only read states
+static void linear_migrate_parallel(void *ctx, size_t begin, size_t end) {
+    LinearMigration *m = ctx;
+    LinearHashMap *map = m->map;
+    size_t dropped = 0;
+    for (size_t i = begin; i < end; i++) {
+        const LinearEntry *e = &m->old[i];
+        if (e->state != OCCUPIED) continue;
+        if (TTL_EXPIRED(map, e)) {
+            dropped++;
+            continue;
+        }
+        size_t idx = hash(e->key, map->seed, map->capacity);
+        size_t step = probe_step(map, e->key);
+        for (size_t probes = 1;
+             !PARALLEL_CAS(&m->fresh[idx].state, EMPTY, OCCUPIED); probes++) {
+            idx = next_slot(map, idx, probes, step);
+        }
+        m->fresh[idx].key = e->key;
+        m->fresh[idx].value = e->value;
+        TTL_SET(&m->fresh[idx], TTL_GET(e));
+        if (m->fresh_access) m->fresh_access[idx] = m->old_access[i];
+    }
+    if (dropped > 0) PARALLEL_FETCH_ADD(&m->dropped, dropped);
+}
+#endif
+
+#ifdef HASHMAP_STATS
+// Wall clock in milliseconds, for resize timing (clock() would add up
+// the CPU time of every migration thread)
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+#endif
+
+// Move every live entry into a fresh table of new_capacity slots, under a
+// new seed when reseed is set. Tombstones and expired entries are dropped
+// Large tables are split over resize_threads threads
+// Keeps the old table (and returns false) if the new one cannot be allocated
+static bool linear_rebuild(LinearHashMap *map, size_t new_capacity, bool reseed) {
+#ifdef HASHMAP_STATS
+    double rebuild_start = now_ms();  // Counted as resize time
+#endif
+    size_t old_cap = map->capacity;
+    LinearEntry *fresh = table_alloc(new_capacity * sizeof(LinearEntry), &map->alloc);
+    if (!fresh) return false;
+    uint32_t *fresh_access = NULL;
+    if (map->access) {
+        fresh_access = calloc(new_capacity, sizeof(uint32_t));
+        if (!fresh_access) {
+            table_free(fresh, new_capacity * sizeof(LinearEntry), &map->alloc);
+            return false;
+        }
+    }
+    
+    // New seed, different from the one that was flooded
+    if (reseed) {
+        unsigned int old_seed = map->seed;
+        do {
+            map->seed = (unsigned int)prng_next(&map->rng);
+        } while (map->seed == old_seed);
+    }
+    map->capacity = new_capacity;
     
-    size_t idx = hash(key, map->capacity);  // Starting index
-    size_t start = idx;                      // Remember start to detect full loop
+    LinearMigration m = {map, map->entries, map->access, fresh, fresh_access, 0};
+    int threads = parallel_threads(map->resize_threads, map->size);
+#ifdef PARALLEL_ATOMICS
+    if (threads > 1) {
+        parallel_for(threads, old_cap, linear_migrate_parallel, &m);
+    } else {
+        linear_migrate_serial(&m, 0, old_cap);
+    }
+#else
+    (void)threads;
+    linear_migrate_serial(&m, 0, old_cap);
+#endif
+    map->size -= m.dropped;
     
-    do {
-        // Found empty or deleted slot
-        // Insert new key-value
-        if (map->entries[idx].state == EMPTY || 
-            map->entries[idx].state == DELETED) {
-            map->entries[idx].key = key;
+    table_free(map->entries, old_cap * sizeof(LinearEntry), &map->alloc);
+    map->entries = fresh;
+    if (fresh_access) {
+        free(map->access);
+        map->access = fresh_access;
+    }
+#ifdef HASHMAP_STATS
+    map->stats.tombstones = 0;  // Not copied into the new table
+    map->stats.resizes++;       // Resizes and reseeds both rebuild
+    map->stats.resize_ms += now_ms() - rebuild_start;
+#endif
+#ifdef HASHMAP_TTL
+    if (map->sweep_cursor >= new_capacity) map->sweep_cursor = 0;
+#endif
+    return true;
+}
+
+// Draw a new seed and reinsert every key into a fresh table
+// Keeps the old table if the new one cannot be allocated
+static void linear_reseed(LinearHashMap *map) {
+    if (!linear_rebuild(map, map->capacity, true)) return;
+    map->reseed_count++;
+    // Reseed at most once per doubling, so each costs O(1) amortized
+    map->reseed_guard = map->size * 2;
+}
+
+// Remove the entry in slot hole without leaving a tombstone
+// Backward shift deletion (Knuth, TAOCP Vol. 3, Algorithm R): later
+// entries of the cluster move into the hole unless that would put them
+// before their home slot. Used in cache mode, where evictions would
+// otherwise fill the table with tombstones
+static void shift_delete(LinearHashMap *map, size_t hole) {
+    size_t cap = map->capacity;
+    size_t j = hole;
+    // The hole is EMPTY from the start, so a scan around a full table
+    // stops when it comes back to it
+    map->entries[hole].state = EMPTY;
+    while (true) {
+        if (++j == cap) j = 0;
+        if (map->entries[j].state != OCCUPIED) break;  // End of cluster
+        size_t home = hash(map->entries[j].key, map->seed, cap);
+        // Home cyclically in (hole, j]: moving would break its probe path
+        bool stays = hole <= j ? (hole < home && home <= j)
+                               : (hole < home || home <= j);
+        if (stays) continue;
+        map->entries[hole] = map->entries[j];
+        map->access[hole] = map->access[j];
+        map->entries[j].state = EMPTY;
+        hole = j;
+    }
+    map->size--;
+}
+
+// Remove the occupied entry in slot idx: a tombstone in a plain map,
+// a backward shift in cache mode
+static void linear_remove_at(LinearHashMap *map, size_t idx) {
+    if (map->cache != CACHE_NONE) {
+        shift_delete(map, idx);
+        return;
+    }
+    map->entries[idx].state = DELETED;  // Tombstone, not EMPTY
+    map->size--;
+    STAT_INC(map, tombstones);
+}
+
+// Slot to evict under CLOCK: advance the hand by clock_stride, giving
+// every referenced entry a second chance by clearing its bit
+static size_t clock_victim(LinearHashMap *map) {
+    while (true) {
+        size_t i = map->clock_hand;
+        map->clock_hand += map->clock_stride;
+        if (map->clock_hand >= map->capacity) map->clock_hand -= map->capacity;
+        if (map->entries[i].state != OCCUPIED) continue;
+        if (map->access[i] == 0) return i;
+        map->access[i] = 0;  // Second chance
+    }
+}
+
+// Slot to evict under sampled LRU: the least recently used of a few
+// random occupied slots (each sample walks forward to an occupied one)
+static size_t lru_victim(LinearHashMap *map) {
+    size_t victim = map->capacity;
+    for (int s = 0; s < CACHE_LRU_SAMPLES; s++) {
+        size_t i = (size_t)(prng_next(&map->rng) % map->capacity);
+        while (map->entries[i].state != OCCUPIED) {
+            if (++i == map->capacity) i = 0;
+        }
+        if (victim == map->capacity ||
+            cache_colder(map->cache, map->tick, map->access[i],
+                         map->access[victim])) {
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+// Cache mode insert: update in place, or evict a victim when the map
+// holds cache_limit keys and insert into the first empty slot
+// There are no tombstones in cache mode, so EMPTY ends every probe
+static bool linear_cache_put(LinearHashMap *map, int key, int value,
+                             size_t home, uint64_t expires) {
+    size_t idx = home;
+    size_t probes = 1;
+    while (map->entries[idx].state == OCCUPIED) {
+        STAT_INC(map, probes);
+        if (map->entries[idx].key == key) {
             map->entries[idx].value = value;
-            map->entries[idx].state = OCCUPIED;
-            map->size++;
+            TTL_SET(&map->entries[idx], expires);
+            map->access[idx] = cache_touch(map->cache, &map->tick);
             return true;
         }
-        // Found existing key
-        // Update value
-        if (map->entries[idx].state == OCCUPIED && 
-            map->entries[idx].key == key) {
+        if (++idx == map->capacity) idx = 0;
+        if (++probes > map->capacity) break;  // Every slot holds another key
+    }
+    
+    // At cache_limit keys (always so when every slot was probed) evict
+    // first, then look for the free slot
+    if (map->size >= map->cache_limit) {
+        size_t victim = map->cache == CACHE_CLOCK ? clock_victim(map)
+                                                  : lru_victim(map);
+        shift_delete(map, victim);
+        map->evictions++;
+        // The shift may have moved entries: find the free slot again
+        idx = home;
+        while (map->entries[idx].state == OCCUPIED) {
+            if (++idx == map->capacity) idx = 0;
+        }
+    }
+    
+    map->entries[idx].key = key;
+    map->entries[idx].value = value;
+    map->entries[idx].state = OCCUPIED;
+    TTL_SET(&map->entries[idx], expires);
+    map->access[idx] = cache_admit(map->cache, &map->tick);
+    map->size++;
+    return true;
+}
+
+// Flood check after an insert that took probes probes: a long probe at
+// low load means colliding keys. Returns true if the table was reseeded
+static bool linear_check_flood(LinearHashMap *map, size_t probes) {
+    if (probes > map->max_probes && map->size > map->reseed_guard &&
+        map->size <= map->capacity * LINEAR_FLOOD_MAX_LOAD) {
+        linear_reseed(map);
+        return true;
+    }
+    return false;
+}
+
+// Slot holding key, or capacity if it is absent
+static size_t linear_find_slot(LinearHashMap *map, int key) {
+    size_t idx = hash(key, map->seed, map->capacity);
+    size_t step = probe_step(map, key);
+    for (size_t n = 1; n <= map->capacity; n++) {
+        if (map->entries[idx].state == EMPTY) break;
+        if (map->entries[idx].state == OCCUPIED && map->entries[idx].key == key) {
+            return idx;
+        }
+        idx = next_slot(map, idx, n, step);
+    }
+    return map->capacity;
+}
+
+// Insert or update a key-value pair starting from home slot idx
+// expires is the entry's deadline (ignored without HASHMAP_TTL)
+static bool linear_put_hashed(LinearHashMap *map, int key, int value,
+                              size_t idx, uint64_t expires) {
+    if (map->cache != CACHE_NONE) {
+        return linear_cache_put(map, key, value, idx, expires);
+    }
+    size_t step = probe_step(map, key);
+    size_t slot = map->capacity;  // First free slot on the path, none yet
+    
+    // The key may sit past a tombstone, so probe on until it or an EMPTY
+    // slot turns up; a new key then takes the first free slot seen
+    // probes counts slots inspected, at most the whole table
+    size_t probes = 1;
+    for (; probes <= map->capacity; probes++) {
+        STAT_INC(map, probes);
+        if (map->entries[idx].state == EMPTY) {
+            if (slot == map->capacity) slot = idx;
+            break;  // Key is absent
+        }
+        if (map->entries[idx].state == DELETED) {
+            if (slot == map->capacity) slot = idx;
+        } else if (map->entries[idx].key == key) {
+            // Found existing key
+            // Update value
             map->entries[idx].value = value;
+            TTL_SET(&map->entries[idx], expires);
             return true;  // No size change, just update
         }
-        // Linear probe: move to next slot
-        idx = (idx + 1) % map->capacity;
-    } while (idx != start);  // Stop if we've checked all slots
+        // Move to next slot of the probe sequence
+        idx = next_slot(map, idx, probes, step);
+    }
+    if (slot == map->capacity) return false;  // Table is full
     
-    return false;  // Table is full
+    // Insert new key-value
+    if (map->entries[slot].state == DELETED) {
+        STAT_DEC(map, tombstones);  // Tombstone reused
+    }
+    map->entries[slot].key = key;
+    map->entries[slot].value = value;
+    map->entries[slot].state = OCCUPIED;
+    TTL_SET(&map->entries[slot], expires);
+    map->size++;
+    linear_check_flood(map, probes);
+    return true;
 }
 
-// Retrieve value for a key
-bool linear_get(LinearHashMap *map, int key, int *value) {
+// Insert or update a key-value pair
+bool linear_put(LinearHashMap *map, int key, int value) {
     if (!map) return false;
+    size_t idx = hash(key, map->seed, map->capacity);  // Starting index
+    return linear_put_hashed(map, key, value, idx, TTL_NEVER);
+}
+
+// Return the value slot of key, inserting it with value 0 if absent, so
+// read-modify-write updates probe once. *inserted (if not NULL) tells
+// whether the key is new. The pointer is valid until the next put, delete
+// or clear, any of which may move entries
+int* linear_find_or_insert(LinearHashMap *map, int key, bool *inserted) {
+    if (inserted) *inserted = false;
+    if (!map || map->capacity == 0) return NULL;
+    
+    size_t cap = map->capacity;
+    size_t home = hash(key, map->seed, cap);
+    size_t idx = home;
+    size_t step = probe_step(map, key);
+    size_t reuse = cap;   // First tombstone passed, preferred for a new key
+    size_t probes = 0;
+    
+    // One probe sequence: stops at the key or at the first EMPTY slot
+    while (probes < cap) {
+        LinearEntry *e = &map->entries[idx];
+        STAT_INC(map, probes);
+        probes++;
+        if (e->state == EMPTY) break;
+        if (e->state == DELETED) {
+            if (reuse == cap) reuse = idx;
+        } else if (e->key == key) {
+            if (TTL_EXPIRED(map, e)) {
+                // Expired: starts over as a new key
+                e->value = 0;
+                TTL_SET(e, TTL_NEVER);
+                if (inserted) *inserted = true;
+            }
+            if (map->access) map->access[idx] = cache_touch(map->cache, &map->tick);
+            STAT_INC(map, hits);
+            return &e->value;
+        }
+        idx = next_slot(map, idx, probes, step);
+    }
+    STAT_INC(map, misses);
+    
+    // Absent. Cache mode may evict and shift entries: insert, then look up
+    if (map->cache != CACHE_NONE) {
+        if (!linear_cache_put(map, key, 0, home, TTL_NEVER)) return NULL;
+        if (inserted) *inserted = true;
+        idx = linear_find_slot(map, key);
+        return &map->entries[idx].value;
+    }
+    if (reuse == cap) {
+        if (probes == cap) return NULL;  // No EMPTY slot and no tombstone
+        reuse = idx;                     // The EMPTY slot that ended the probe
+    } else {
+        STAT_DEC(map, tombstones);  // Tombstone reused
+    }
+    
+    LinearEntry *e = &map->entries[reuse];
+    e->key = key;
+    e->value = 0;
+    e->state = OCCUPIED;
+    TTL_SET(e, TTL_NEVER);
+    map->size++;
+    if (inserted) *inserted = true;
+    // A reseed moves every entry: find the new slot
+    if (linear_check_flood(map, probes)) reuse = linear_find_slot(map, key);
+    return &map->entries[reuse].value;
+}
+
+// Add delta to the value of key, which starts at 0 if absent
+bool linear_add(LinearHashMap *map, int key, int delta) {
+    int *slot = linear_find_or_insert(map, key, NULL);
+    if (!slot) return false;
+    *slot += delta;
+    return true;
+}
+
+// Insert n pairs, hashing each group of HASH_BATCH keys in one pass
+// Returns the number of pairs stored
+size_t linear_put_batch(LinearHashMap *map, const int *keys,
+                        const int *values, size_t n) {
+    if (!map || !keys || !values) return 0;
     
-    size_t idx = hash(key, map->capacity);  // Starting index
-    size_t start = idx;
+    size_t stored = 0;
+    unsigned int h[HASH_BATCH];
+    for (size_t base = 0; base < n; base += HASH_BATCH) {
+        size_t count = n - base < HASH_BATCH ? n - base : HASH_BATCH;
+        unsigned int seed = map->seed;
+        hash_batch(keys + base, seed, h, count);
+        for (size_t i = 0; i < count; i++) {
+            // A flood reseed moves every key: rehash the rest
+            if (map->seed != seed) {
+                seed = map->seed;
+                hash_batch(keys + base + i, seed, h + i, count - i);
+            }
+            if (linear_put_hashed(map, keys[base + i], values[base + i],
+                                  h[i] % map->capacity, TTL_NEVER)) {
+                stored++;
+            }
+        }
+    }
+    return stored;
+}
+
+// Retrieve value for a key starting from home slot idx
+// An expired entry is a miss and is removed on the spot
+static bool linear_get_hashed(LinearHashMap *map, int key, int *value,
+                              size_t idx) {
+    size_t step = probe_step(map, key);
     
-    do {
+    for (size_t probes = 1; probes <= map->capacity; probes++) {
+        STAT_INC(map, probes);
         // EMPTY means key was never here
         if (map->entries[idx].state == EMPTY) {
+            STAT_INC(map, misses);
             return false;
         }
         // Check if this slot has our key
         if (map->entries[idx].state == OCCUPIED && 
             map->entries[idx].key == key) {
+            if (TTL_EXPIRED(map, &map->entries[idx])) {
+                linear_remove_at(map, idx);
+                break;
+            }
             if (value) *value = map->entries[idx].value;
+            if (map->access) {
+                map->access[idx] = cache_touch(map->cache, &map->tick);
+            }
+            STAT_INC(map, hits);
             return true;
         }
         // Continue probing
-        // Linear probe
-        // Move to next slot
-        idx = (idx + 1) % map->capacity;
-    } while (idx != start);
+        // Move to next slot of the probe sequence
+        idx = next_slot(map, idx, probes, step);
+    }
     
+    STAT_INC(map, misses);
     return false;  // Not found
 }
 
+// Retrieve value for a key
+bool linear_get(LinearHashMap *map, int key, int *value) {
+    if (!map) return false;
+    size_t idx = hash(key, map->seed, map->capacity);  // Starting index
+    return linear_get_hashed(map, key, value, idx);
+}
+
+// Look up n keys, hashing each group of HASH_BATCH keys in one pass
+// values[i] (if values is not NULL) is set and found[i] (if found is not
+// NULL) tells whether keys[i] was present. Returns the number found
+size_t linear_get_batch(LinearHashMap *map, const int *keys, int *values,
+                        bool *found, size_t n) {
+    if (!map || !keys) return 0;
+    
+    size_t hits = 0;
+    unsigned int h[HASH_BATCH];
+    for (size_t base = 0; base < n; base += HASH_BATCH) {
+        size_t count = n - base < HASH_BATCH ? n - base : HASH_BATCH;
+        hash_batch(keys + base, map->seed, h, count);
+        for (size_t i = 0; i < count; i++) {
+            bool hit = linear_get_hashed(map, keys[base + i],
+                                         values ? &values[base + i] : NULL,
+                                         h[i] % map->capacity);
+            if (found) found[base + i] = hit;
+            if (hit) hits++;
+        }
+    }
+    return hits;
+}
+
 // Delete a key
-// Marks the slot as DELETED
+// Marks the slot as DELETED (cache mode shifts the cluster back instead)
 bool linear_delete(LinearHashMap *map, int key) {
     if (!map) return false;
     
-    size_t idx = hash(key, map->capacity);
-    size_t start = idx;
+    size_t idx = hash(key, map->seed, map->capacity);
+    size_t step = probe_step(map, key);
     
-    do {
+    for (size_t probes = 1; probes <= map->capacity; probes++) {
+        STAT_INC(map, probes);
         // EMPTY means key was never here
         if (map->entries[idx].state == EMPTY) {
             return false;
@@ -130,16 +718,28 @@ bool linear_delete(LinearHashMap *map, int key) {
         // Mark as deleted
         if (map->entries[idx].state == OCCUPIED && 
             map->entries[idx].key == key) {
-            map->entries[idx].state = DELETED;  // Tombstone, not EMPTY
-            map->size--;
-            return true;
+            // An expired key is already gone, but its slot is freed here
+            bool live = !TTL_EXPIRED(map, &map->entries[idx]);
+            linear_remove_at(map, idx);
+            return live;
         }
-        idx = (idx + 1) % map->capacity;
-    } while (idx != start);
+        idx = next_slot(map, idx, probes, step);
+    }
     
     return false;  // Key not found
 }
 
+// Move every entry into a table of new_capacity slots (rounded up to a
+// power of two for quadratic and double hashing), dropping tombstones
+// Fails in cache mode, if new_capacity cannot hold every key, or if the
+// new table cannot be allocated; the map is unchanged then
+bool linear_resize(LinearHashMap *map, size_t new_capacity) {
+    if (!map || map->cache != CACHE_NONE) return false;
+    if (map->probe != PROBE_LINEAR) new_capacity = round_pow2(new_capacity);
+    if (new_capacity == 0 || new_capacity < map->size) return false;
+    return linear_rebuild(map, new_capacity, false);
+}
+
 // Return number of stored elements
 size_t linear_size(LinearHashMap *map) {
     return map ? map->size : 0;
@@ -148,20 +748,48 @@ size_t linear_size(LinearHashMap *map) {
 // Calculate total memory usage
 size_t linear_memory_usage(LinearHashMap *map) {
     if (!map) return 0;
-    // Main struct + all entries
+    // Main struct + all entries (+ access words in cache mode)
     // No additional dynamic allocations per entry
-    return sizeof(LinearHashMap) + map->capacity * sizeof(LinearEntry);
+    size_t access = map->access ? map->capacity * sizeof(uint32_t) : 0;
+    return sizeof(LinearHashMap) + map->capacity * sizeof(LinearEntry) + access;
+}
+
+// Build a read-only minimal perfect hash copy of the current contents
+// The map itself is left untouched and may keep changing
+FrozenMap* linear_freeze(LinearHashMap *map) {
+    if (!map) return NULL;
+    
+    size_t n = map->size;
+    int *keys = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *values = malloc((n > 0 ? n : 1) * sizeof(int));
+    FrozenMap *frozen = NULL;
+    if (keys && values) {
+        // Collect live entries, skipping empty and deleted slots
+        size_t k = 0;
+        for (size_t i = 0; i < map->capacity && k < n; i++) {
+            if (map->entries[i].state == OCCUPIED &&
+                !TTL_EXPIRED(map, &map->entries[i])) {
+                keys[k] = map->entries[i].key;
+                values[k] = map->entries[i].value;
+                k++;
+            }
+        }
+        frozen = frozen_build(keys, values, k, prng_next(&map->rng));
+    }
+    free(keys);
+    free(values);
+    return frozen;
 }
 
 // Count probes needed to find or determine absence of key
 int linear_probe_count(LinearHashMap *map, int key) {
     if (!map) return 0;
     
-    size_t idx = hash(key, map->capacity);
-    size_t start = idx;
+    size_t idx = hash(key, map->seed, map->capacity);
+    size_t step = probe_step(map, key);
     int probes = 0; // Probe counter
     
-    do {
+    for (size_t n = 1; n <= map->capacity; n++) {
         probes++;  // Count this probe
         // EMPTY ends the search
         if (map->entries[idx].state == EMPTY) {
@@ -172,8 +800,173 @@ int linear_probe_count(LinearHashMap *map, int key) {
             map->entries[idx].key == key) {
             return probes;
         }
-        idx = (idx + 1) % map->capacity; // Next slot
-    } while (idx != start); // Full loop
+        idx = next_slot(map, idx, n, step); // Next slot
+    } // Full loop
     
     return probes;  // Searched entire table
-}
\ No newline at end of file
+}
+
+// Return number of keys evicted in cache mode
+size_t linear_evictions(LinearHashMap *map) {
+    return map ? map->evictions : 0;
+}
+
+// Return number of flood-triggered reseeds
+int linear_reseed_count(LinearHashMap *map) {
+    return map ? map->reseed_count : 0;
+}
+
+// Probes from home with step until slot target, or to the first EMPTY slot
+// when target is capacity
+static size_t probe_length(LinearHashMap *map, size_t home, size_t step,
+                           size_t target) {
+    size_t idx = home;
+    size_t probes = 1;
+    while (probes < map->capacity && idx != target &&
+           map->entries[idx].state != EMPTY) {
+        idx = next_slot(map, idx, probes, step);
+        probes++;
+    }
+    return probes;
+}
+
+// Histograms for quadratic and double hashing, walking each sequence
+// A double hashing miss also depends on the key's step, so each home slot
+// is measured with the step of a stand-in key equal to the slot index
+static size_t probe_histogram_walk(LinearHashMap *map, size_t *hit_hist,
+                                   size_t *miss_hist, size_t bins) {
+    size_t max_hit = 0;
+    for (size_t idx = 0; idx < map->capacity; idx++) {
+        if (miss_hist) {
+            size_t step = probe_step(map, (int)idx);
+            size_t miss_len = probe_length(map, idx, step, map->capacity);
+            miss_hist[miss_len < bins ? miss_len : bins - 1]++;
+        }
+        LinearEntry *e = &map->entries[idx];
+        if (e->state == OCCUPIED) {
+            size_t home = hash(e->key, map->seed, map->capacity);
+            size_t hit_len = probe_length(map, home, probe_step(map, e->key), idx);
+            if (hit_hist) hit_hist[hit_len < bins ? hit_len : bins - 1]++;
+            if (hit_len > max_hit) max_hit = hit_len;
+        }
+    }
+    return max_hit;
+}
+
+// Fill probe-length histograms in a single backward pass over the table
+// hit_hist[k]:  stored keys found after exactly k probes
+// miss_hist[k]: home slots from which a failed search takes k probes
+// Lengths of bins - 1 or more land in the last bin, either array may be NULL
+// Returns the longest successful probe length
+size_t linear_probe_histogram(LinearHashMap *map, size_t *hit_hist,
+                              size_t *miss_hist, size_t bins) {
+    if (!map || bins == 0 || map->capacity == 0) return 0;
+    
+    for (size_t k = 0; k < bins; k++) { // Clear bins
+        if (hit_hist) hit_hist[k] = 0;
+        if (miss_hist) miss_hist[k] = 0;
+    }
+    if (map->probe != PROBE_LINEAR) {
+        return probe_histogram_walk(map, hit_hist, miss_hist, bins);
+    }
+    
+    // A failed search stops at the first EMPTY slot, so walk backwards
+    // from one: each slot needs one more probe than the slot after it
+    size_t cap = map->capacity;
+    size_t empty = cap;
+    for (size_t i = 0; i < cap; i++) {
+        if (map->entries[i].state == EMPTY) {
+            empty = i;
+            break;
+        }
+    }
+    
+    size_t max_hit = 0;
+    size_t miss_len = 0;  // Probes for a failed search from slot idx
+    size_t idx = (empty == cap) ? cap - 1 : empty;
+    for (size_t n = 0; n < cap; n++) {
+        LinearEntry *e = &map->entries[idx];
+        
+        if (empty == cap) {
+            miss_len = cap;  // No EMPTY slot: every miss scans the table
+        } else if (e->state == EMPTY) {
+            miss_len = 1;
+        } else {
+            miss_len++;
+        }
+        if (miss_hist) miss_hist[miss_len < bins ? miss_len : bins - 1]++;
+        
+        // A hit costs its distance from the home slot plus one
+        if (e->state == OCCUPIED) {
+            size_t home = hash(e->key, map->seed, cap);
+            size_t hit_len = (idx + cap - home) % cap + 1;
+            if (hit_hist) hit_hist[hit_len < bins ? hit_len : bins - 1]++;
+            if (hit_len > max_hit) max_hit = hit_len;
+        }
+        idx = (idx == 0) ? cap - 1 : idx - 1;  // Step backwards
+    }
+    return max_hit;
+}
+
+// Copy operational counters into out
+// Returns false (and zeroes out) when built without HASHMAP_STATS
+bool linear_stats(LinearHashMap *map, LinearStats *out) {
+    if (!out) return false;
+    memset(out, 0, sizeof(*out));
+#ifdef HASHMAP_STATS
+    if (!map) return false;
+    *out = map->stats;
+    return true;
+#else
+    (void)map;
+    return false;
+#endif
+}
+// Insert or update a pair that expires ttl ticks after the current map time
+// A ttl of 0 never expires. Returns false when built without HASHMAP_TTL
+bool linear_put_ttl(LinearHashMap *map, int key, int value, uint64_t ttl) {
+#ifdef HASHMAP_TTL
+    if (!map) return false;
+    size_t idx = hash(key, map->seed, map->capacity);
+    return linear_put_hashed(map, key, value, idx, ttl_deadline(map->now, ttl));
+#else
+    (void)map; (void)key; (void)value; (void)ttl;
+    return false;
+#endif
+}
+
+// Set the map clock; entries whose deadline is at or before now are expired
+void linear_set_time(LinearHashMap *map, uint64_t now) {
+#ifdef HASHMAP_TTL
+    if (map) map->now = now;
+#else
+    (void)map; (void)now;
+#endif
+}
+
+// Remove expired entries in the next max_slots slots, resuming where the
+// previous call stopped, so the cost per call is bounded
+// Returns the number of entries removed
+size_t linear_expire_step(LinearHashMap *map, size_t max_slots) {
+#ifdef HASHMAP_TTL
+    if (!map) return 0;
+    if (max_slots > map->capacity) max_slots = map->capacity;
+    
+    size_t removed = 0;
+    for (size_t n = 0; n < max_slots; n++) {
+        size_t idx = map->sweep_cursor;
+        if (map->entries[idx].state == OCCUPIED &&
+            TTL_EXPIRED(map, &map->entries[idx])) {
+            // A backward shift may move a later entry into idx; it is
+            // checked on the next round
+            linear_remove_at(map, idx);
+            removed++;
+        }
+        map->sweep_cursor = idx + 1 == map->capacity ? 0 : idx + 1;
+    }
+    return removed;
+#else
+    (void)map; (void)max_slots;
+    return 0;
+#endif
+}
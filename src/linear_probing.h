@@ -10,6 +10,29 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include "hashmap_stats.h"
+#include "hashmap_ttl.h"
+#include "prng.h"
+#include "frozen.h"
+#include "cache_policy.h"
+#include "table_alloc.h"
+
+// Default probe count for one insert that is treated as hash flooding
+// Only checked up to LINEAR_FLOOD_MAX_LOAD, where random keys stay far below it
+#define LINEAR_FLOOD_PROBES 128
+#define LINEAR_FLOOD_MAX_LOAD 0.5
+
+// Load a cache mode map holds before inserts start evicting
+// Keeps probe sequences short without ever resizing
+#define LINEAR_CACHE_MAX_LOAD 0.75
+
+// Probe sequence followed after a collision
+typedef enum {
+    PROBE_LINEAR = 0,   // home, home + 1, home + 2, ... (default)
+    PROBE_QUADRATIC,    // Triangular offsets home + i(i+1)/2
+    PROBE_DOUBLE        // home + i * step, step from a second hash of the key
+} ProbeStrategy;
 
 // Slot states for tracking entry status
 typedef enum {
@@ -23,22 +46,85 @@ typedef struct {
     int key;         // Key stored in slot
     int value;       // Value associated with key
     SlotState state; // Current state of slot
+#ifdef HASHMAP_TTL
+    uint64_t expires; // Deadline on the map clock, TTL_NEVER if none
+#endif
 } LinearEntry;
 
+// Operational counters, filled only when built with HASHMAP_STATS
+typedef struct {
+    size_t probes;      // Slots inspected by put/get/delete
+    size_t hits;        // Successful lookups
+    size_t misses;      // Failed lookups
+    size_t tombstones;  // DELETED slots currently in the table
+    size_t resizes;     // Table rebuilds (linear_resize and flood reseeds)
+    double resize_ms;   // Wall time spent in them
+} LinearStats;
+
+// Creation options for linear_create_with
+// A zeroed struct gives the same map as linear_create
+typedef struct {
+    TableAllocOptions alloc;  // How the entry array is allocated
+    uint64_t seed;            // PRNG seed for hash seeds, 0 = random per map
+    size_t max_probes;        // Flood threshold, 0 = LINEAR_FLOOD_PROBES, SIZE_MAX = off
+    CachePolicy cache;        // Bounded cache mode eviction, CACHE_NONE = plain map
+    ProbeStrategy probe;      // Collision sequence, PROBE_LINEAR = default
+                              // Others round capacity up to a power of two
+                              // Cache mode always probes linearly
+    int resize_threads;       // Threads moving entries in resizes and reseeds, 0 = 1
+} LinearOptions;
+
 // Main hash map structure
 typedef struct {
     LinearEntry *entries;  // Array of entries
     size_t capacity;       // Total number of slots
     size_t size;           // Number of occupied slots
+    TableAllocOptions alloc; // Allocation mode of entries
+    unsigned int seed;     // Seed mixed into the hash function
+    ProbeStrategy probe;   // Collision sequence
+    size_t max_probes;     // Insert probe count that triggers a reseed
+    size_t reseed_guard;   // No further reseed until size passes this
+    int reseed_count;      // Number of flood-triggered reseeds
+    int resize_threads;    // Threads used to move entries into a new table
+    Prng rng;              // Per-map generator for hash seeds
+    CachePolicy cache;     // Eviction policy, CACHE_NONE for a plain map
+    uint32_t *access;      // Reference bit / LRU stamp per slot (cache mode only)
+    size_t cache_limit;    // Keys held before an insert evicts
+    size_t clock_hand;     // Next slot the CLOCK sweep inspects
+    size_t clock_stride;   // Hand step, coprime with capacity
+    uint32_t tick;         // Logical clock for LRU stamps
+    size_t evictions;      // Keys evicted to make room
+#ifdef HASHMAP_STATS
+    LinearStats stats;     // Operational counters
+#endif
+#ifdef HASHMAP_TTL
+    uint64_t now;          // Map clock that deadlines are compared against
+    size_t sweep_cursor;   // Next slot for linear_expire_step
+#endif
 } LinearHashMap;
 
 LinearHashMap* linear_create(size_t capacity); // Create a new linear probing hash map
+LinearHashMap* linear_create_with(size_t capacity, const LinearOptions *opts); // Create with options (NULL for defaults)
 void linear_destroy(LinearHashMap *map); // Destroy the hash map and free memory
+void linear_clear(LinearHashMap *map); // Remove all entries, keeping the table for reuse
 bool linear_put(LinearHashMap *map, int key, int value); // Insert or update a key value pair
 bool linear_get(LinearHashMap *map, int key, int *value); // Retrieve value for key value pair
+int* linear_find_or_insert(LinearHashMap *map, int key, bool *inserted); // Value slot of key, inserting 0 if absent (inserted may be NULL). Valid until the next mutation, NULL on failure
+bool linear_add(LinearHashMap *map, int key, int delta); // Add delta to key's value, starting from 0 if absent
+size_t linear_put_batch(LinearHashMap *map, const int *keys, const int *values, size_t n); // Insert n pairs, hashing keys in vector batches. Returns pairs stored
+size_t linear_get_batch(LinearHashMap *map, const int *keys, int *values, bool *found, size_t n); // Look up n keys (values, found may be NULL). Returns keys found
 bool linear_delete(LinearHashMap *map, int key); // Delete a key value pair
+bool linear_resize(LinearHashMap *map, size_t new_capacity); // Move every entry into a table of new_capacity slots (not in cache mode)
 size_t linear_size(LinearHashMap *map); // Get number of stored elements
 size_t linear_memory_usage(LinearHashMap *map); // Get total memory usage in bytes
+FrozenMap* linear_freeze(LinearHashMap *map); // Build a read-only perfect hash copy (map is unchanged). NULL on failure
 int linear_probe_count(LinearHashMap *map, int key); // Count probes needed to find or miss a key
+int linear_reseed_count(LinearHashMap *map); // Get number of flood-triggered reseeds
+size_t linear_evictions(LinearHashMap *map); // Get number of keys evicted in cache mode
+size_t linear_probe_histogram(LinearHashMap *map, size_t *hit_hist, size_t *miss_hist, size_t bins); // Count keys and home slots by probe length. Returns longest hit
+bool linear_stats(LinearHashMap *map, LinearStats *out); // Copy counters. Returns false if stats are compiled out
+bool linear_put_ttl(LinearHashMap *map, int key, int value, uint64_t ttl); // Insert or update a pair that expires ttl ticks from now (0 = never). False if TTL is compiled out
+void linear_set_time(LinearHashMap *map, uint64_t now); // Advance the map clock used for expiry
+size_t linear_expire_step(LinearHashMap *map, size_t max_slots); // Reclaim expired entries from at most max_slots slots. Returns entries removed
 
 #endif
\ No newline at end of file
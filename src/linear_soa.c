@@ -0,0 +1,244 @@
+/*
+ * Structure-of-Arrays Linear Probing Hash Map Implementation
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * Same probing as linear_probing.c, but LinearEntry's key, value and state
+ * are split into three arrays. A probe sequence scans keys only, sixteen
+ * per cache line instead of about five entries, and finds the end of the
+ * cluster by counting trailing bits of the occupancy word rather than
+ * reading a state per slot. Deletion shifts the cluster back (no
+ * tombstones), so one bit per slot is enough state.
+ */
+
+#include "linear_soa.h"
+#include "prng.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Hash function using MurmurHash-inspired bit mixing
+* Code adapted from Appleby, A. (2011). MurmurHash3 fmix32() finalizer.
+* Retrieved from https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp.
+* The bit-mixing sequence and associated constants in the hash_with_seed function
+* were adapted from the fmix32() finalizer of MurmurHash3.
+*/
+static size_t hash(int key, unsigned int seed, size_t capacity) {
+    unsigned int k = (unsigned int)key;
+    k ^= seed;           // Mix in the per-map seed
+    k ^= (k >> 16);      // Mix high bits down
+    k *= 0x85ebca6b;     // Multiply by magic constant
+    k ^= (k >> 13);      // More mixing
+    k *= 0xc2b2ae35;     // Another constant
+    k ^= (k >> 16);      // Final mix
+    return k % capacity; // Reduce to valid index
+}
+
+// Index of the lowest set bit of a non-zero word
+static int lowest_bit(uint64_t bits) {
+#ifdef __GNUC__
+    return __builtin_ctzll(bits);
+#else
+    int i = 0;
+    while (!(bits & 1u)) {
+        bits >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+// Whether slot i holds a key
+static bool slot_used(LinearSoaMap *map, size_t i) {
+    return (map->used[i / LINEAR_SOA_WORD_BITS] >> (i % LINEAR_SOA_WORD_BITS)) & 1u;
+}
+
+// Number of occupancy words for capacity slots
+static size_t word_count(size_t capacity) {
+    return capacity / LINEAR_SOA_WORD_BITS;
+}
+
+// Create a new SoA linear probing hash map
+LinearSoaMap* linear_soa_create(size_t capacity) {
+    LinearSoaMap *map = malloc(sizeof(LinearSoaMap));
+    if (!map) return NULL;
+    
+    // Whole occupancy words, so a run never crosses the end of the table
+    // in the middle of a word
+    if (capacity < LINEAR_SOA_WORD_BITS) capacity = LINEAR_SOA_WORD_BITS;
+    capacity = (capacity + LINEAR_SOA_WORD_BITS - 1) / LINEAR_SOA_WORD_BITS *
+               LINEAR_SOA_WORD_BITS;
+    
+    // Keys and values are only read where the bitmap says a key lives,
+    // so they need no initialization
+    map->keys = malloc(capacity * sizeof(int));
+    map->values = malloc(capacity * sizeof(int));
+    map->used = calloc(word_count(capacity), sizeof(uint64_t));
+    if (!map->keys || !map->values || !map->used) {
+        free(map->keys);
+        free(map->values);
+        free(map->used);
+        free(map);
+        return NULL;
+    }
+    
+    map->capacity = capacity;
+    map->size = 0;
+    Prng rng;
+    prng_seed(&rng, prng_default_seed(map));
+    map->seed = (unsigned int)prng_next(&rng);
+    return map;
+}
+
+// Free all memory
+void linear_soa_destroy(LinearSoaMap *map) {
+    if (!map) return;
+    free(map->keys);
+    free(map->values);
+    free(map->used);
+    free(map);
+}
+
+// Remove every entry but keep the arrays for reuse
+// Only the bitmap needs clearing
+void linear_soa_clear(LinearSoaMap *map) {
+    if (!map) return;
+    memset(map->used, 0, word_count(map->capacity) * sizeof(uint64_t));
+    map->size = 0;
+}
+
+// Locate key by scanning its cluster one occupancy word at a time
+// Returns the slot index, or capacity if the key is absent, in which case
+// *empty_out (may be NULL) receives the empty slot that ended the cluster
+// probes (may be NULL) receives the number of slots inspected
+static size_t find_slot(LinearSoaMap *map, int key, size_t *empty_out,
+                        int *probes) {
+    size_t cap = map->capacity;
+    size_t idx = hash(key, map->seed, cap);
+    int inspected = 0;
+#ifdef __GNUC__
+    // Home key and value usually share their line with the hit: start
+    // both misses now so they overlap with the bitmap read
+    __builtin_prefetch(&map->keys[idx]);
+    __builtin_prefetch(&map->values[idx]);
+#endif
+    
+    // put keeps one slot empty, so every cluster ends
+    while (true) {
+        size_t bit = idx % LINEAR_SOA_WORD_BITS;
+        // Bit j set: slot idx + j is empty (bits past the word read as used)
+        uint64_t free_bits = ~map->used[idx / LINEAR_SOA_WORD_BITS] >> bit;
+        size_t run = free_bits ? (size_t)lowest_bit(free_bits)
+                               : LINEAR_SOA_WORD_BITS - bit;
+        
+        // Occupied slots idx .. idx + run - 1: compare keys only
+        for (size_t j = 0; j < run; j++) {
+            if (map->keys[idx + j] == key) {
+                if (probes) *probes = inspected + (int)j + 1;
+                return idx + j;
+            }
+        }
+        inspected += (int)run;
+        
+        if (free_bits) {
+            // Empty slot ends the cluster
+            if (empty_out) *empty_out = idx + run;
+            if (probes) *probes = inspected + 1;
+            return cap;
+        }
+        idx += run;  // Cluster continues in the next word
+        if (idx == cap) idx = 0;
+    }
+}
+
+// Remove the key in slot hole without leaving a tombstone
+// Backward shift deletion (Knuth, TAOCP Vol. 3, Algorithm R), as in
+// linear_probing.c's cache mode: later keys of the cluster move into the
+// hole unless that would put them before their home slot
+static void shift_delete(LinearSoaMap *map, size_t hole) {
+    size_t cap = map->capacity;
+    size_t j = hole;
+    while (true) {
+        if (++j == cap) j = 0;
+        if (!slot_used(map, j)) break;  // End of cluster
+        size_t home = hash(map->keys[j], map->seed, cap);
+        // Home cyclically in (hole, j]: moving would break its probe path
+        bool stays = hole <= j ? (hole < home && home <= j)
+                               : (hole < home || home <= j);
+        if (stays) continue;
+        map->keys[hole] = map->keys[j];
+        map->values[hole] = map->values[j];
+        hole = j;
+    }
+    map->used[hole / LINEAR_SOA_WORD_BITS] &=
+        ~((uint64_t)1 << (hole % LINEAR_SOA_WORD_BITS));
+    map->size--;
+}
+
+// Insert or update a key-value pair
+// One slot always stays empty so probes terminate
+bool linear_soa_put(LinearSoaMap *map, int key, int value) {
+    if (!map) return false;
+    
+    size_t empty;
+    size_t idx = find_slot(map, key, &empty, NULL);
+    if (idx < map->capacity) {
+        map->values[idx] = value;  // Update existing value
+        return true;
+    }
+    if (map->size + 1 >= map->capacity) return false;  // Full
+    
+    map->keys[empty] = key;
+    map->values[empty] = value;
+    map->used[empty / LINEAR_SOA_WORD_BITS] |=
+        (uint64_t)1 << (empty % LINEAR_SOA_WORD_BITS);
+    map->size++;
+    return true;
+}
+
+// Retrieve value for a key
+// The value array is read only on a hit
+bool linear_soa_get(LinearSoaMap *map, int key, int *value) {
+    if (!map) return false;
+    size_t idx = find_slot(map, key, NULL, NULL);
+    if (idx == map->capacity) return false;  // Not found
+    if (value) *value = map->values[idx];
+    return true;
+}
+
+// Delete a key
+bool linear_soa_delete(LinearSoaMap *map, int key) {
+    if (!map) return false;
+    size_t idx = find_slot(map, key, NULL, NULL);
+    if (idx == map->capacity) return false;  // Key not found
+    shift_delete(map, idx);
+    return true;
+}
+
+// Return number of stored elements
+size_t linear_soa_size(LinearSoaMap *map) {
+    return map ? map->size : 0;
+}
+
+// Calculate total memory usage
+size_t linear_soa_memory_usage(LinearSoaMap *map) {
+    if (!map) return 0;
+    // Main struct + key and value arrays + occupancy bitmap
+    return sizeof(LinearSoaMap) + map->capacity * 2 * sizeof(int) +
+           word_count(map->capacity) * sizeof(uint64_t);
+}
+
+// Count slots inspected to find or determine absence of key
+// A miss counts the empty slot that ends the cluster, like linear_probe_count
+int linear_soa_probe_count(LinearSoaMap *map, int key) {
+    if (!map) return 0;
+    int probes = 0;
+    find_slot(map, key, NULL, &probes);
+    return probes;
+}
+
+// Calculate current load factor
+double linear_soa_load_factor(LinearSoaMap *map) {
+    if (!map || map->capacity == 0) return 0.0;
+    return (double)map->size / map->capacity;
+}
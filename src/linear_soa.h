@@ -0,0 +1,42 @@
+/*
+ * Structure-of-Arrays Linear Probing Hash Map Header
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ */
+
+#ifndef LINEAR_SOA_H // Include guard
+#define LINEAR_SOA_H // Prevent multiple inclusions
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Slots per occupancy word; capacity is rounded up to a multiple of it
+#define LINEAR_SOA_WORD_BITS 64
+
+// Main hash map structure
+// Keys, values and occupancy live in separate arrays, so a probe reads
+// 4-byte keys (16 per cache line) and one bit per slot, and the value
+// array is only touched on a hit
+typedef struct {
+    int *keys;          // Key of each slot
+    int *values;        // Value of each slot, read only on a hit
+    uint64_t *used;     // Occupancy bitmap, bit i set: slot i holds a key
+    size_t capacity;    // Total number of slots (multiple of 64)
+    size_t size;        // Number of occupied slots
+    unsigned int seed;  // Seed mixed into the hash function
+} LinearSoaMap;
+
+LinearSoaMap* linear_soa_create(size_t capacity); // Create a new SoA linear probing hash map
+void linear_soa_destroy(LinearSoaMap *map); // Destroy the hash map and free memory
+void linear_soa_clear(LinearSoaMap *map); // Remove all entries, keeping the arrays for reuse
+bool linear_soa_put(LinearSoaMap *map, int key, int value); // Insert or update a key value pair
+bool linear_soa_get(LinearSoaMap *map, int key, int *value); // Retrieve value for key value pair
+bool linear_soa_delete(LinearSoaMap *map, int key); // Delete a key value pair
+size_t linear_soa_size(LinearSoaMap *map); // Get number of stored elements
+size_t linear_soa_memory_usage(LinearSoaMap *map); // Get total memory usage in bytes
+int linear_soa_probe_count(LinearSoaMap *map, int key); // Count slots inspected to find or miss a key
+double linear_soa_load_factor(LinearSoaMap *map); // Get current load factor
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * Parallel Migration Implementation
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * A resize moves every entry of the old table into a new one, and the
+ * entries are independent: the old table can be cut into chunks that
+ * several threads move at once. parallel_for starts POSIX threads for one
+ * migration and hands out chunks from a shared counter, so a thread that
+ * lands on dense chunks does not hold up the rest. The maps claim slots in
+ * the new table with compare-and-swap, so no locks are taken per entry.
+ */
+
+#include "parallel.h"
+#include <pthread.h>
+
+// Shared state of one parallel_for call
+typedef struct {
+    ParallelChunkFn fn;
+    void *ctx;
+    size_t n;                // Items in the range
+    size_t next;             // Start of the next unclaimed chunk
+    pthread_mutex_t lock;    // Guards next
+} ParallelRun;
+
+// Threads a migration of items entries should use
+int parallel_threads(int requested, size_t items) {
+#ifdef PARALLEL_ATOMICS
+    if (requested <= 1 || items < PARALLEL_MIN_ITEMS) return 1;
+    return requested > PARALLEL_MAX_THREADS ? PARALLEL_MAX_THREADS : requested;
+#else
+    (void)requested; (void)items;
+    return 1;  // No slot claiming without atomics
+#endif
+}
+
+// Thread body: claim chunks until the range is exhausted
+static void* parallel_worker(void *p) {
+    ParallelRun *run = p;
+    while (true) {
+        pthread_mutex_lock(&run->lock);
+        size_t begin = run->next;
+        if (begin < run->n) run->next += PARALLEL_CHUNK;
+        pthread_mutex_unlock(&run->lock);
+        if (begin >= run->n) break;
+
+        size_t end = run->n - begin < PARALLEL_CHUNK ? run->n : begin + PARALLEL_CHUNK;
+        run->fn(run->ctx, begin, end);
+    }
+    return NULL;
+}
+
+// Run fn over [0, n) in chunks on nthreads threads, the caller included
+void parallel_for(int nthreads, size_t n, ParallelChunkFn fn, void *ctx) {
+    if (nthreads < 1) nthreads = 1;
+    if (nthreads > PARALLEL_MAX_THREADS) nthreads = PARALLEL_MAX_THREADS;
+    if (nthreads == 1) {
+        fn(ctx, 0, n);  // No threads, no chunking
+        return;
+    }
+
+    ParallelRun run;
+    run.fn = fn;
+    run.ctx = ctx;
+    run.n = n;
+    run.next = 0;
+    pthread_mutex_init(&run.lock, NULL);
+
+    pthread_t threads[PARALLEL_MAX_THREADS];
+    int started = 0;
+    for (int t = 1; t < nthreads; t++) {
+        if (pthread_create(&threads[started], NULL, parallel_worker, &run) != 0) {
+            break;  // The running threads take over its chunks
+        }
+        started++;
+    }
+    parallel_worker(&run);  // The caller works too
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    pthread_mutex_destroy(&run.lock);
+}
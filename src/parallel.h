@@ -0,0 +1,44 @@
+/*
+ * Parallel Migration Header
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ */
+
+#ifndef PARALLEL_H // Include guard
+#define PARALLEL_H // Prevent multiple inclusions
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Most threads one parallel_for call starts
+#define PARALLEL_MAX_THREADS 64
+
+// Old slots (or buckets) handed to a thread at a time
+#define PARALLEL_CHUNK (1 << 14)
+
+// Tables smaller than this are always migrated by the calling thread
+#define PARALLEL_MIN_ITEMS (1 << 16)
+
+// Atomic helpers for lock-free slot claiming (GCC and Clang builtins)
+// Without them parallel_threads reports 1 and every migration is serial
+#ifdef __GNUC__
+#define PARALLEL_ATOMICS 1
+#define PARALLEL_CAS(ptr, old, val) __sync_bool_compare_and_swap((ptr), (old), (val))
+#define PARALLEL_FETCH_ADD(ptr, delta) __sync_fetch_and_add((ptr), (delta))
+#endif
+
+// Process items [begin, end) of a parallel_for range
+typedef void (*ParallelChunkFn)(void *ctx, size_t begin, size_t end);
+
+// Threads a migration of items entries should use, given the map's
+// resize_threads option (0 or 1 = serial)
+int parallel_threads(int requested, size_t items);
+
+// Run fn over [0, n) in PARALLEL_CHUNK pieces on nthreads threads, the
+// caller included. Threads take the next chunk until none are left, and
+// the call returns when every chunk is done. If a thread cannot be
+// started the others (at least the caller) pick up its share
+void parallel_for(int nthreads, size_t n, ParallelChunkFn fn, void *ctx);
+
+#endif
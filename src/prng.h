@@ -0,0 +1,76 @@
+/*
+ * Per-Map Pseudo Random Number Generator
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * xoshiro256** seeded through splitmix64, as recommended by
+ * Blackman, D., & Vigna, S. (2021). Scrambled linear pseudorandom
+ * number generators. ACM Transactions on Mathematical Software, 47(4).
+ * Retrieved from https://prng.di.unimi.it/.
+ * Each map owns its state, so drawing seeds never takes the global
+ * rand() lock or disturbs the sequence other code gets from rand().
+ */
+
+#ifndef PRNG_H // Include guard
+#define PRNG_H // Prevent multiple inclusions
+
+#include <stdint.h>
+#include <time.h>
+
+// Generator state (must not be all zero, prng_seed guarantees that)
+typedef struct {
+    uint64_t s[4];
+} Prng;
+
+// One splitmix64 step: advances *state and returns a mixed value
+static inline uint64_t splitmix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Expand a 64-bit seed into a full generator state
+static inline void prng_seed(Prng *rng, uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = splitmix64(&seed);
+    }
+}
+
+// Rotate left helper for xoshiro
+static inline uint64_t prng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Next 64 random bits (xoshiro256**)
+static inline uint64_t prng_next(Prng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = prng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = prng_rotl(s[3], 45);
+    return result;
+}
+
+// Pick a seed for a map created without one
+// Mixes wall time, CPU time, the map's address and a creation counter
+// so maps created in the same second still get different seeds
+static inline uint64_t prng_default_seed(const void *map) {
+    static uint64_t created = 0;
+#ifdef __GNUC__
+    uint64_t count = __atomic_fetch_add(&created, 1, __ATOMIC_RELAXED);
+#else
+    uint64_t count = created++;
+#endif
+    uint64_t state = (uint64_t)time(NULL) ^ ((uint64_t)clock() << 32) ^
+                     (uint64_t)(uintptr_t)map;
+    state ^= splitmix64(&count);
+    return splitmix64(&state);
+}
+
+#endif
@@ -0,0 +1,171 @@
+/*
+ * Table Allocation Implementation
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * Large slot arrays are accessed at random, so with 4 KB pages almost
+ * every lookup misses the dTLB. The mmap modes map anonymous memory
+ * (zeroed by the kernel on first touch, so creation does not write every
+ * page), align it to 2 MB and either request transparent huge pages with
+ * madvise(MADV_HUGEPAGE) or explicit huge pages with MAP_HUGETLB.
+ * NUMA placement uses the mbind(2) system call directly so no libnuma
+ * dependency is needed. Every step past plain mmap is best effort.
+ * table_reset relies on the same zero pages: clearing a large table
+ * drops its pages instead of rewriting every byte.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE // MAP_ANONYMOUS, MAP_HUGETLB, madvise, syscall
+#endif
+
+#include "table_alloc.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Below this size rewriting the table beats a page fault per page
+#define RESET_ZERO_PAGE_MIN ((size_t)1024 * 1024)
+
+// Replace a large heap table with fresh calloc memory (zero pages)
+// Falls back to memset if the new allocation fails
+static void* reset_heap(void *ptr, size_t bytes) {
+    if (bytes >= RESET_ZERO_PAGE_MIN) {
+        void *fresh = calloc(1, bytes);
+        if (fresh) {
+            free(ptr);
+            return fresh;
+        }
+    }
+    memset(ptr, 0, bytes);
+    return ptr;
+}
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define HUGE_PAGE_SIZE ((size_t)2 * 1024 * 1024) // 2 MB huge page
+
+// mbind policies from <numaif.h>, redefined to avoid libnuma headers
+#define NUMA_MPOL_BIND 2
+#define NUMA_MPOL_INTERLEAVE 3
+
+// Round the mapping length so huge page mappings cover whole pages
+static size_t mapping_length(size_t bytes, TableAllocMode mode) {
+    if (mode == TABLE_ALLOC_MMAP) return bytes;
+    return (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+}
+
+// Map len bytes starting on a 2 MB boundary so THP can back all of it
+static void* map_aligned(size_t len) {
+    size_t span = len + HUGE_PAGE_SIZE;  // Room to slide to alignment
+    char *raw = mmap(NULL, span, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return NULL;
+
+    // Trim the unaligned head and the unused tail
+    size_t head = (HUGE_PAGE_SIZE - ((size_t)raw & (HUGE_PAGE_SIZE - 1))) &
+                  (HUGE_PAGE_SIZE - 1);
+    if (head > 0) munmap(raw, head);
+    size_t tail = span - head - len;
+    if (tail > 0) munmap(raw + head + len, tail);
+    return raw + head;
+}
+
+// Apply the NUMA policy to a fresh mapping before it is touched
+static void apply_numa(void *ptr, size_t len, const TableAllocOptions *opts) {
+    unsigned long nodemask;
+    int policy;
+
+    if (opts->numa == TABLE_NUMA_BIND) {
+        if (opts->numa_node < 0 || opts->numa_node >= 64) return;
+        nodemask = 1UL << opts->numa_node;
+        policy = NUMA_MPOL_BIND;
+    } else if (opts->numa == TABLE_NUMA_INTERLEAVE) {
+        nodemask = ~0UL;  // Kernel clips to the nodes we may use
+        policy = NUMA_MPOL_INTERLEAVE;
+    } else {
+        return;
+    }
+    // Failure (no NUMA support, bad node) leaves the default policy
+    syscall(SYS_mbind, ptr, len, policy, &nodemask, 64, 0);
+}
+
+// Allocate bytes of zeroed memory
+void* table_alloc(size_t bytes, const TableAllocOptions *opts) {
+    if (bytes == 0) bytes = 1;  // Keep a unique, freeable pointer
+    if (!opts || opts->mode == TABLE_ALLOC_HEAP) {
+        return calloc(1, bytes);
+    }
+
+    size_t len = mapping_length(bytes, opts->mode);
+    void *ptr = NULL;
+
+    if (opts->mode == TABLE_ALLOC_HUGETLB) {
+        // Needs pages reserved in /proc/sys/vm/nr_hugepages
+        ptr = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr == MAP_FAILED) ptr = NULL;
+    }
+    if (!ptr && opts->mode != TABLE_ALLOC_MMAP) {
+        ptr = map_aligned(len);
+#ifdef MADV_HUGEPAGE
+        if (ptr) madvise(ptr, len, MADV_HUGEPAGE);
+#endif
+    }
+    if (!ptr && opts->mode == TABLE_ALLOC_MMAP) {
+        ptr = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) ptr = NULL;
+    }
+
+    if (ptr) apply_numa(ptr, len, opts);
+    return ptr;
+}
+
+// Release memory from table_alloc
+void table_free(void *ptr, size_t bytes, const TableAllocOptions *opts) {
+    if (!ptr) return;
+    if (!opts || opts->mode == TABLE_ALLOC_HEAP) {
+        free(ptr);
+        return;
+    }
+    if (bytes == 0) bytes = 1;
+    munmap(ptr, mapping_length(bytes, opts->mode));
+}
+
+// Zero a table from table_alloc for reuse and return it
+void* table_reset(void *ptr, size_t bytes, const TableAllocOptions *opts) {
+    if (!ptr || bytes == 0) return ptr;
+    if (!opts || opts->mode == TABLE_ALLOC_HEAP) {
+        return reset_heap(ptr, bytes);
+    }
+    // Dropping private anonymous pages makes the next touch a zero page
+    if (bytes < RESET_ZERO_PAGE_MIN ||
+        madvise(ptr, mapping_length(bytes, opts->mode), MADV_DONTNEED) != 0) {
+        memset(ptr, 0, bytes);
+    }
+    return ptr;
+}
+
+#else // No mmap/madvise: every mode is plain calloc
+
+void* table_alloc(size_t bytes, const TableAllocOptions *opts) {
+    (void)opts;
+    return calloc(1, bytes ? bytes : 1);
+}
+
+void table_free(void *ptr, size_t bytes, const TableAllocOptions *opts) {
+    (void)bytes;
+    (void)opts;
+    free(ptr);
+}
+
+void* table_reset(void *ptr, size_t bytes, const TableAllocOptions *opts) {
+    (void)opts;
+    if (!ptr || bytes == 0) return ptr;
+    return reset_heap(ptr, bytes);
+}
+
+#endif
@@ -0,0 +1,47 @@
+/*
+ * Table Allocation Header
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ */
+
+#ifndef TABLE_ALLOC_H // Include guard
+#define TABLE_ALLOC_H // Prevent multiple inclusions
+
+#include <stddef.h>
+
+// How a slot array is obtained from the OS
+typedef enum {
+    TABLE_ALLOC_HEAP = 0,  // calloc (default)
+    TABLE_ALLOC_MMAP,      // Anonymous mmap, pages zeroed lazily on first touch
+    TABLE_ALLOC_HUGEPAGE,  // mmap + MADV_HUGEPAGE (transparent 2 MB pages)
+    TABLE_ALLOC_HUGETLB    // Explicit 2 MB pages, falls back to HUGEPAGE
+} TableAllocMode;
+
+// NUMA placement for mmap based modes
+typedef enum {
+    TABLE_NUMA_DEFAULT = 0,  // Kernel default (first touch)
+    TABLE_NUMA_BIND,         // All pages on numa_node
+    TABLE_NUMA_INTERLEAVE    // Pages spread round robin over all nodes
+} TableNumaPolicy;
+
+// Allocation options shared by the open addressing maps
+// A zeroed struct selects plain calloc
+typedef struct {
+    TableAllocMode mode;   // Page source
+    TableNumaPolicy numa;  // Node placement, ignored for TABLE_ALLOC_HEAP
+    int numa_node;         // Target node for TABLE_NUMA_BIND
+} TableAllocOptions;
+
+// Allocate bytes of zeroed memory. opts may be NULL for calloc
+void* table_alloc(size_t bytes, const TableAllocOptions *opts);
+
+// Release memory from table_alloc. bytes and opts must match the allocation
+void table_free(void *ptr, size_t bytes, const TableAllocOptions *opts);
+
+// Zero a table from table_alloc for reuse and return it
+// Large tables are handed back to the kernel for fresh zero pages instead
+// of being rewritten, so the returned pointer may differ from ptr
+void* table_reset(void *ptr, size_t bytes, const TableAllocOptions *opts);
+
+#endif
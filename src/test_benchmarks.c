@@ -9,90 +9,145 @@
  *   - Knuth, TAOCP Vol. 3, Sorting and Searching
  *   - Cormen et al., Introduction to Algorithms, chapter on hashing
  *   - Pagh and Rodler, "Cuckoo Hashing", Journal of Algorithms 51(2), 2004
+ *   - Herlihy, Shavit and Tzafrir, "Hopscotch Hashing", DISC 2008
  */
 
 #include "test_benchmarks.h"
 #include "test_utils.h"
+#include "test_threads.h"
 #include "chained.h"
 #include "linear_probing.h"
 #include "cuckoo.h"
+#include "hopscotch.h"
+#include "linear_soa.h"
+#include "chained_unrolled.h"
+#include "cuckoo_filter.h"
+#include "parallel.h"
+#include "wal.h"
+#include "hash_simd.h"
+#include "frozen.h"
+#include "hashmap_template.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// int/int template instantiations compared against the hand-written maps
+DEFINE_CHAINED_MAP(IntChained, int, int, hashmap_int_hash, hashmap_int_eq)
+DEFINE_LINEAR_MAP(IntLinear, int, int, hashmap_int_hash, hashmap_int_eq)
+DEFINE_CUCKOO_MAP(IntCuckoo, int, int, hashmap_int_hash, hashmap_int_eq)
+
+// Number of histogram bins printed by benchmark_distributions
+// The last bin collects everything at or above HIST_BINS - 1
+#define HIST_BINS 10
+
+// Create a cuckoo map seeded from benchmark_seed() so runs with --seed
+// build identical tables and can be compared A/B
+static CuckooHashMap* bench_cuckoo_create(size_t capacity) {
+    CuckooOptions opts = {0};
+    opts.seed = benchmark_seed();
+    return cuckoo_create_with(capacity, &opts);
+}
 
 // Benchmark insertion performance
 BenchmarkResult benchmark_insertion(int *keys, int n, size_t capacity) {
-    BenchmarkResult result = {0, 0, 0, 0};
+    BenchmarkResult result = {0};
     double start, end;
     
     // Benchmark Chained HashMap insertion
     ChainedHashMap *ch = chained_create(capacity);
+    perf_start();
     start = get_time_ms(); // Start timing
     for (int i = 0; i < n; i++) {
         chained_put(ch, keys[i], i);
     }
     end = get_time_ms(); // End timing
     result.chained_ms = end - start;
+    result.chained_perf = perf_stop(n);
     chained_destroy(ch);
     
     // Benchmark Linear Probing insertion
     LinearHashMap *lh = linear_create(capacity);
+    perf_start();
     start = get_time_ms(); // Start timing
     for (int i = 0; i < n; i++) {
         linear_put(lh, keys[i], i);
     }
     end = get_time_ms(); // End timing
     result.linear_ms = end - start;
+    result.linear_perf = perf_stop(n);
     linear_destroy(lh);
     
     // Benchmark Cuckoo insertion
-    CuckooHashMap *cu = cuckoo_create(capacity);
+    CuckooHashMap *cu = bench_cuckoo_create(capacity);
+    perf_start();
     start = get_time_ms(); // Start timing
     for (int i = 0; i < n; i++) {
         cuckoo_put(cu, keys[i], i);
     }
     end = get_time_ms();
     result.cuckoo_ms = end - start;
+    result.cuckoo_perf = perf_stop(n);
     result.cuckoo_rehashes = cuckoo_rehash_count(cu);
     cuckoo_destroy(cu);
     
+    // Benchmark Hopscotch insertion
+    HopscotchHashMap *hs = hopscotch_create(capacity);
+    perf_start();
+    start = get_time_ms(); // Start timing
+    for (int i = 0; i < n; i++) {
+        hopscotch_put(hs, keys[i], i);
+    }
+    end = get_time_ms();
+    result.hopscotch_ms = end - start;
+    result.hopscotch_perf = perf_stop(n);
+    hopscotch_destroy(hs);
+    
     return result;
 }
 
 // Benchmark lookup performance
 BenchmarkResult benchmark_lookup(int *keys, int n, size_t capacity) {
-    BenchmarkResult result = {0, 0, 0, 0}; // Initialize result
+    BenchmarkResult result = {0}; // Initialize result
     double start, end;
     int val;
     
     // Build all tables with the same data first
     ChainedHashMap *ch = chained_create(capacity);
     LinearHashMap *lh = linear_create(capacity);
-    CuckooHashMap *cu = cuckoo_create(capacity);
+    CuckooHashMap *cu = bench_cuckoo_create(capacity);
+    HopscotchHashMap *hs = hopscotch_create(capacity);
     
     // Insert all keys
     for (int i = 0; i < n; i++) {
         chained_put(ch, keys[i], i);
         linear_put(lh, keys[i], i);
         cuckoo_put(cu, keys[i], i);
+        hopscotch_put(hs, keys[i], i);
     }
     
     // Benchmark Chained lookups
+    perf_start();
     start = get_time_ms(); // Start timing
     for (int i = 0; i < n; i++) {
         chained_get(ch, keys[i], &val);
     }
     end = get_time_ms();
     result.chained_ms = end - start;
+    result.chained_perf = perf_stop(n);
     
     // Benchmark Linear Probing lookups
+    perf_start();
     start = get_time_ms(); // Start timing
     for (int i = 0; i < n; i++) {
         linear_get(lh, keys[i], &val);
     }
     end = get_time_ms(); // End timing
     result.linear_ms = end - start;
+    result.linear_perf = perf_stop(n);
     
     // Benchmark Cuckoo lookups
+    perf_start();
     start = get_time_ms(); // Start timing
     for (int i = 0; i < n; i++) {
         cuckoo_get(cu, keys[i], &val);
@@ -100,60 +155,91 @@ BenchmarkResult benchmark_lookup(int *keys, int n, size_t capacity) {
     // Benchmark Cuckoo lookups
     end = get_time_ms(); // End timing
     result.cuckoo_ms = end - start;
+    result.cuckoo_perf = perf_stop(n);
     result.cuckoo_rehashes = cuckoo_rehash_count(cu);
     
+    // Benchmark Hopscotch lookups
+    perf_start();
+    start = get_time_ms(); // Start timing
+    for (int i = 0; i < n; i++) {
+        hopscotch_get(hs, keys[i], &val);
+    }
+    end = get_time_ms(); // End timing
+    result.hopscotch_ms = end - start;
+    result.hopscotch_perf = perf_stop(n);
+    
     // Clean up
     chained_destroy(ch);
     linear_destroy(lh);
     cuckoo_destroy(cu);
+    hopscotch_destroy(hs);
     
     return result;
 }
 
 // Benchmark deletion performance
 BenchmarkResult benchmark_deletion(int *keys, int n, size_t capacity) {
-    BenchmarkResult result = {0, 0, 0, 0};
+    BenchmarkResult result = {0};
     double start, end;
     
     // Build all tables first
     ChainedHashMap *ch = chained_create(capacity);
     LinearHashMap *lh = linear_create(capacity);
-    CuckooHashMap *cu = cuckoo_create(capacity);
+    CuckooHashMap *cu = bench_cuckoo_create(capacity);
+    HopscotchHashMap *hs = hopscotch_create(capacity);
     
     // Insert all keys
     for (int i = 0; i < n; i++) {
         chained_put(ch, keys[i], i);
         linear_put(lh, keys[i], i);
         cuckoo_put(cu, keys[i], i);
+        hopscotch_put(hs, keys[i], i);
     }
     
     // Benchmark Chained deletions
+    perf_start();
     start = get_time_ms(); // Start timing
     for (int i = 0; i < n; i++) {
         chained_delete(ch, keys[i]);
     }
     end = get_time_ms(); // End timing
     result.chained_ms = end - start;
+    result.chained_perf = perf_stop(n);
     
     // Benchmark Linear Probing deletions
+    perf_start();
     start = get_time_ms(); // Start timing
     for (int i = 0; i < n; i++) {
         linear_delete(lh, keys[i]);
     }
     end = get_time_ms(); // End timing
     result.linear_ms = end - start;
+    result.linear_perf = perf_stop(n);
     
     // Benchmark Cuckoo deletions
+    perf_start();
     start = get_time_ms(); // Start timing
     for (int i = 0; i < n; i++) {
         cuckoo_delete(cu, keys[i]);
     }
     end = get_time_ms(); // End timing
     result.cuckoo_ms = end - start;
+    result.cuckoo_perf = perf_stop(n);
+    
+    // Benchmark Hopscotch deletions
+    perf_start();
+    start = get_time_ms(); // Start timing
+    for (int i = 0; i < n; i++) {
+        hopscotch_delete(hs, keys[i]);
+    }
+    end = get_time_ms(); // End timing
+    result.hopscotch_ms = end - start;
+    result.hopscotch_perf = perf_stop(n);
     
     chained_destroy(ch);
     linear_destroy(lh);
     cuckoo_destroy(cu);
+    hopscotch_destroy(hs);
     
     return result;
 }
@@ -166,14 +252,18 @@ void benchmark_memory(int n, size_t capacity) {
     
     // Create and fill all maps
     ChainedHashMap *ch = chained_create(capacity);
+    ChainedUnrolledMap *cun = chained_unrolled_create(capacity);
     LinearHashMap *lh = linear_create(capacity);
-    CuckooHashMap *cu = cuckoo_create(capacity);
+    CuckooHashMap *cu = bench_cuckoo_create(capacity);
+    HopscotchHashMap *hs = hopscotch_create(capacity);
     
     // Insert all keys
     for (int i = 0; i < n; i++) {
         chained_put(ch, keys[i], i);
+        chained_unrolled_put(cun, keys[i], i);
         linear_put(lh, keys[i], i);
         cuckoo_put(cu, keys[i], i);
+        hopscotch_put(hs, keys[i], i);
     }
     
     // Report memory usage and structure-specific metrics
@@ -181,14 +271,32 @@ void benchmark_memory(int n, size_t capacity) {
     printf("Elements stored: %d\n\n", n);
     printf("Chained:        %zu bytes (max chain: %d)\n", 
            chained_memory_usage(ch), chained_max_chain_length(ch));
+    printf("Chained (unrolled): %zu bytes (blocks: %zu)\n",
+           chained_unrolled_memory_usage(cun), chained_unrolled_block_count(cun));
     printf("Linear Probing: %zu bytes\n", 
            linear_memory_usage(lh));
     printf("Cuckoo:         %zu bytes (load: %.2f%%)\n", 
            cuckoo_memory_usage(cu), cuckoo_load_factor(cu) * 100);
+    printf("Hopscotch:      %zu bytes (load: %.2f%%, resizes: %d)\n",
+           hopscotch_memory_usage(hs), hopscotch_load_factor(hs) * 100,
+           hopscotch_resize_count(hs));
+    
+    // Operational counters gathered during the inserts (stats builds only)
+    CuckooStats cs;
+    LinearStats ls;
+    if (cuckoo_stats(cu, &cs) && linear_stats(lh, &ls)) {
+        printf("\nLinear probes: %zu (%.2f per insert), rebuilds: %zu (%.3f ms)\n",
+               ls.probes, (double)ls.probes / n, ls.resizes, ls.resize_ms);
+        printf("Cuckoo displacements: %zu, max kick chain: %zu, "
+               "resizes: %zu (%.3f ms)\n", cs.displacements,
+               cs.max_kick_chain, cs.resizes, cs.resize_ms);
+    }
     
     chained_destroy(ch); 
+    chained_unrolled_destroy(cun);
     linear_destroy(lh);
     cuckoo_destroy(cu);
+    hopscotch_destroy(hs);
     free(keys);
 }
 
@@ -201,30 +309,38 @@ void benchmark_worst_case_lookup(int n, size_t capacity) {
     // Create and fill all maps
     ChainedHashMap *ch = chained_create(capacity);
     LinearHashMap *lh = linear_create(capacity);
-    CuckooHashMap *cu = cuckoo_create(capacity);
+    CuckooHashMap *cu = bench_cuckoo_create(capacity);
+    HopscotchHashMap *hs = hopscotch_create(capacity);
     
     // Insert all keys
     for (int i = 0; i < n; i++) {
         chained_put(ch, keys[i], i);
         linear_put(lh, keys[i], i);
         cuckoo_put(cu, keys[i], i);
+        hopscotch_put(hs, keys[i], i);
     }
     
-    // Find worst-case probes for linear probing
+    // Find worst-case probes for linear probing and hopscotch
     int max_probes = 0;
+    int max_hop_probes = 0;
     for (int i = 0; i < n; i++) {
         int probes = linear_probe_count(lh, keys[i]);
         if (probes > max_probes) max_probes = probes;
+        probes = hopscotch_probe_count(hs, keys[i]);
+        if (probes > max_hop_probes) max_hop_probes = probes;
     }
     
     // Report worst-case metrics
     printf("Chained max chain length:  %d\n", chained_max_chain_length(ch));
     printf("Linear probing max probes: %d\n", max_probes);
     printf("Cuckoo max lookups:        2 (guaranteed)\n");
+    printf("Hopscotch max probes:      %d (bound %d)\n", max_hop_probes,
+           HOPSCOTCH_NEIGHBORHOOD);
     
     chained_destroy(ch);
     linear_destroy(lh);
     cuckoo_destroy(cu);
+    hopscotch_destroy(hs);
     free(keys);
 }
 
@@ -235,9 +351,9 @@ void benchmark_scaling(void) {
     int sizes[] = {1000, 5000, 10000, 25000, 50000, 75000, 100000, 125000, 150000, 175000, 200000};
     int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
     
-    printf("%-10s | %-12s | %-12s | %-12s\n", 
-           "Size", "Chained", "Linear", "Cuckoo");
-    printf("-----------|--------------|--------------|-------------\n");
+    printf("%-10s | %-12s | %-12s | %-12s | %-12s\n", 
+           "Size", "Chained", "Linear", "Cuckoo", "Hopscotch");
+    printf("-----------|--------------|--------------|--------------|-------------\n");
     
     for (int s = 0; s < num_sizes; s++) {
         int n = sizes[s];
@@ -246,21 +362,1656 @@ void benchmark_scaling(void) {
         
         BenchmarkResult r = benchmark_insertion(keys, n, capacity);
         
-        printf("%-10d | %10.3f ms | %10.3f ms | %10.3f ms\n",
-               n, r.chained_ms, r.linear_ms, r.cuckoo_ms);
+        printf("%-10d | %10.3f ms | %10.3f ms | %10.3f ms | %10.3f ms\n",
+               n, r.chained_ms, r.linear_ms, r.cuckoo_ms, r.hopscotch_ms);
+        
+        free(keys);
+    }
+}
+
+// Print one histogram row from bin first up to HIST_BINS - 1
+// Bins at or above HIST_BINS - 1 are folded into the last column
+static void print_histogram_row(const char *label, const size_t *hist,
+                                size_t bins, size_t first) {
+    printf("  %-16s", label);
+    for (size_t k = first; k < HIST_BINS - 1; k++) {
+        printf(" %7zu", hist[k]);
+    }
+    size_t tail = 0;
+    for (size_t k = HIST_BINS - 1; k < bins; k++) tail += hist[k];
+    printf(" %7zu\n", tail);
+}
+
+// Print the column labels of a histogram row starting at bin first
+static void print_histogram_header(const char *label, size_t first) {
+    printf("  %-16s", label);
+    for (size_t k = first; k < HIST_BINS; k++) {
+        printf(" %6zu%s", k, k == HIST_BINS - 1 ? "+" : " ");
+    }
+    printf("\n");
+}
+
+// Mean of a histogram whose bin k holds items of length k
+static double histogram_mean(const size_t *hist, size_t bins) {
+    double total = 0, count = 0;
+    for (size_t k = 0; k < bins; k++) {
+        total += (double)k * hist[k];
+        count += hist[k];
+    }
+    return count > 0 ? total / count : 0.0;
+}
+
+// Show full chain/probe length distributions against theory
+// Chained lengths follow Poisson(alpha); linear probing means follow
+// Knuth's 1/2(1 + 1/(1-a)) for hits and 1/2(1 + 1/(1-a)^2) for misses
+void benchmark_distributions(void) {
+    print_section_header("PROBE AND CHAIN LENGTH DISTRIBUTIONS");
+    
+    double loads[] = {0.25, 0.5, 0.75, 0.9};
+    int num_loads = sizeof(loads) / sizeof(loads[0]);
+    size_t slots = 100000;  // Total slots per map at every load
+    
+    // Histograms are gathered at full resolution so the means are exact,
+    // then folded into HIST_BINS columns for printing
+    size_t *chain_hist = malloc(slots * sizeof(size_t));
+    size_t *hit_hist = malloc(slots * sizeof(size_t));
+    size_t *miss_hist = malloc(slots * sizeof(size_t));
+    if (!chain_hist || !hit_hist || !miss_hist) {
+        free(chain_hist);
+        free(hit_hist);
+        free(miss_hist);
+        return;
+    }
+    
+    for (int l = 0; l < num_loads; l++) {
+        double alpha = loads[l];
+        int n = (int)(alpha * slots);
+        int *keys = generate_random_keys(n);
+        
+        ChainedHashMap *ch = chained_create(slots);
+        LinearHashMap *lh = linear_create(slots);
+        CuckooHashMap *cu = bench_cuckoo_create(slots / 2);  // Same total slots
+        for (int i = 0; i < n; i++) {
+            chained_put(ch, keys[i], i);
+            linear_put(lh, keys[i], i);
+            cuckoo_put(cu, keys[i], i);
+        }
+        
+        size_t table_hist[2];
+        size_t max_chain = chained_chain_histogram(ch, chain_hist, slots);
+        size_t max_hit = linear_probe_histogram(lh, hit_hist, miss_hist, slots);
+        cuckoo_table_histogram(cu, table_hist, 2);
+        
+        // Expected bucket counts under Poisson(alpha)
+        size_t poisson[HIST_BINS];
+        double p = exp(-alpha), tail = 1.0;
+        for (size_t k = 0; k < HIST_BINS - 1; k++) {
+            poisson[k] = (size_t)(p * slots + 0.5);
+            tail -= p;
+            p *= alpha / (double)(k + 1);
+        }
+        poisson[HIST_BINS - 1] = (size_t)(tail * slots + 0.5);
+        
+        printf("Load factor %.2f (%d keys, %zu slots)\n", alpha, n, slots);
+        print_histogram_header("Chain length", 0);
+        print_histogram_row("Chained buckets", chain_hist, slots, 0);
+        print_histogram_row("Poisson expect", poisson, HIST_BINS, 0);
+        printf("  Chained max chain: %zu\n", max_chain);
+        
+        print_histogram_header("Probes", 1);
+        print_histogram_row("Linear hits", hit_hist, slots, 1);
+        print_histogram_row("Linear misses", miss_hist, slots, 1);
+        printf("  Linear mean hit probes:  %.2f (Knuth %.2f, max %zu)\n",
+               histogram_mean(hit_hist, slots), 0.5 * (1 + 1 / (1 - alpha)),
+               max_hit);
+        printf("  Linear mean miss probes: %.2f (Knuth %.2f)\n",
+               histogram_mean(miss_hist, slots),
+               0.5 * (1 + 1 / ((1 - alpha) * (1 - alpha))));
+        printf("  Cuckoo residence: table1 %zu, table2 %zu (load %.2f)\n\n",
+               table_hist[0], table_hist[1], cuckoo_load_factor(cu));
+        
+        chained_destroy(ch);
+        linear_destroy(lh);
+        cuckoo_destroy(cu);
+        free(keys);
+    }
+    
+    free(chain_hist);
+    free(hit_hist);
+    free(miss_hist);
+}
+
+// Compare 4 KB and huge page tables for dTLB-bound random lookups
+// slots is the total slot count of each map (100M+ to exceed TLB reach)
+void benchmark_hugepages(size_t slots) {
+    print_section_header("HUGE PAGE TABLE ALLOCATION");
+    
+    TableAllocMode modes[] = {TABLE_ALLOC_HEAP, TABLE_ALLOC_HUGEPAGE,
+                              TABLE_ALLOC_HUGETLB};
+    const char *names[] = {"calloc (4 KB)", "mmap + THP", "MAP_HUGETLB"};
+    int num_modes = sizeof(modes) / sizeof(modes[0]);
+    int n = (int)(slots * 0.4);  // Stays under cuckoo's resize threshold
+    int *keys = generate_random_keys(n);
+    if (!keys) return;
+    
+    perf_init();
+    printf("%zu slots per map, %d keys, %d random lookups\n\n", slots, n, n);
+    
+    int val;
+    for (int m = 0; m < num_modes; m++) {
+        double start, end;
+        PerfSample ps;
+        
+        LinearOptions lo = {0};
+        lo.alloc.mode = modes[m];
+        LinearHashMap *lh = linear_create_with(slots, &lo);
+        CuckooOptions co = {0};
+        co.alloc.mode = modes[m];
+        co.seed = benchmark_seed();
+        CuckooHashMap *cu = cuckoo_create_with(slots / 2, &co);
+        if (!lh || !cu) {
+            printf("%-14s allocation failed\n", names[m]);
+            linear_destroy(lh);
+            cuckoo_destroy(cu);
+            continue;
+        }
+        for (int i = 0; i < n; i++) {
+            linear_put(lh, keys[i], i);
+            cuckoo_put(cu, keys[i], i);
+        }
+        
+        perf_start();
+        start = get_time_ms();
+        for (int i = 0; i < n; i++) {
+            linear_get(lh, keys[i], &val);
+        }
+        end = get_time_ms();
+        ps = perf_stop(n);
+        printf("%-14s Linear: %9.3f ms", names[m], end - start);
+        perf_print_sample(ps);
+        printf("\n");
+        
+        perf_start();
+        start = get_time_ms();
+        for (int i = 0; i < n; i++) {
+            cuckoo_get(cu, keys[i], &val);
+        }
+        end = get_time_ms();
+        ps = perf_stop(n);
+        printf("%-14s Cuckoo: %9.3f ms", names[m], end - start);
+        perf_print_sample(ps);
+        printf("\n");
+        
+        linear_destroy(lh);
+        cuckoo_destroy(cu);
+    }
+    
+    perf_shutdown();
+    free(keys);
+}
+
+// Short-lived maps: create/fill/destroy per round versus one map cleared
+// per round. Each round stores only a few keys, so the cost is dominated
+// by how much of the table creation or clearing touches
+void benchmark_create_clear(void) {
+    print_section_header("CREATE/DESTROY VS CLEAR (SHORT-LIVED MAPS)");
+    
+    size_t capacities[] = {1024, 65536, 1048576};
+    int num_caps = sizeof(capacities) / sizeof(capacities[0]);
+    int keys_per_round = 64;
+    int *keys = generate_random_keys(keys_per_round);
+    if (!keys) return;
+    
+    printf("%-10s | %-8s | %-14s | %-14s\n", "Capacity", "Map",
+           "create+destroy", "clear");
+    printf("-----------|----------|----------------|---------------\n");
+    
+    for (int c = 0; c < num_caps; c++) {
+        size_t cap = capacities[c];
+        int rounds = (int)((1u << 26) / cap);  // Scale work with table size
+        if (rounds < 20) rounds = 20;
+        double start, fresh_us, reuse_us;
+        
+        // Chained
+        start = get_time_ms();
+        for (int r = 0; r < rounds; r++) {
+            ChainedHashMap *ch = chained_create(cap);
+            for (int i = 0; i < keys_per_round; i++) chained_put(ch, keys[i], i);
+            chained_destroy(ch);
+        }
+        fresh_us = (get_time_ms() - start) * 1000.0 / rounds;
+        ChainedHashMap *ch = chained_create(cap);
+        start = get_time_ms();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < keys_per_round; i++) chained_put(ch, keys[i], i);
+            chained_clear(ch);
+        }
+        reuse_us = (get_time_ms() - start) * 1000.0 / rounds;
+        chained_destroy(ch);
+        printf("%-10zu | %-8s | %11.2f us | %11.2f us\n", cap, "Chained",
+               fresh_us, reuse_us);
+        
+        // Linear probing
+        start = get_time_ms();
+        for (int r = 0; r < rounds; r++) {
+            LinearHashMap *lh = linear_create(cap);
+            for (int i = 0; i < keys_per_round; i++) linear_put(lh, keys[i], i);
+            linear_destroy(lh);
+        }
+        fresh_us = (get_time_ms() - start) * 1000.0 / rounds;
+        LinearHashMap *lh = linear_create(cap);
+        start = get_time_ms();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < keys_per_round; i++) linear_put(lh, keys[i], i);
+            linear_clear(lh);
+        }
+        reuse_us = (get_time_ms() - start) * 1000.0 / rounds;
+        linear_destroy(lh);
+        printf("%-10zu | %-8s | %11.2f us | %11.2f us\n", cap, "Linear",
+               fresh_us, reuse_us);
+        
+        // Cuckoo (capacity is per table)
+        start = get_time_ms();
+        for (int r = 0; r < rounds; r++) {
+            CuckooHashMap *cu = bench_cuckoo_create(cap / 2);
+            for (int i = 0; i < keys_per_round; i++) cuckoo_put(cu, keys[i], i);
+            cuckoo_destroy(cu);
+        }
+        fresh_us = (get_time_ms() - start) * 1000.0 / rounds;
+        CuckooHashMap *cu = bench_cuckoo_create(cap / 2);
+        start = get_time_ms();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < keys_per_round; i++) cuckoo_put(cu, keys[i], i);
+            cuckoo_clear(cu);
+        }
+        reuse_us = (get_time_ms() - start) * 1000.0 / rounds;
+        cuckoo_destroy(cu);
+        printf("%-10zu | %-8s | %11.2f us | %11.2f us\n", cap, "Cuckoo",
+               fresh_us, reuse_us);
+    }
+    
+    free(keys);
+}
+
+// Rehashes at high load with and without a stash
+// Growth is pushed to just under 50% so every insert happens at high load
+void benchmark_cuckoo_stash(void) {
+    print_section_header("CUCKOO STASH AT HIGH LOAD");
+    
+    int stash_sizes[] = {-1, CUCKOO_STASH_SIZE, 8};  // -1 = no stash
+    int num_stash = sizeof(stash_sizes) / sizeof(stash_sizes[0]);
+    double loads[] = {0.40, 0.45, 0.48, 0.49};
+    int num_loads = sizeof(loads) / sizeof(loads[0]);
+    // Small tables fail chains far more often, which makes the effect visible
+    size_t capacity = 1000;  // Per table
+    int trials = 200;
+    
+    printf("%-6s | %-8s | %-10s | %-10s | %-12s\n", "Load", "Stash",
+           "Rehashes", "Stashed", "Insert time");
+    printf("-------|----------|------------|------------|-------------\n");
+    
+    for (int l = 0; l < num_loads; l++) {
+        int n = (int)(loads[l] * 2 * capacity);
+        for (int s = 0; s < num_stash; s++) {
+            int rehashes = 0, stashed = 0;
+            double total_ms = 0;
+            for (int t = 0; t < trials; t++) {
+                int *keys = generate_random_keys(n);
+                CuckooOptions opts = {0};
+                opts.seed = benchmark_seed() ? benchmark_seed() + t : 0;
+                opts.stash_size = stash_sizes[s];
+                opts.max_load = 0.499;  // Never grow during the run
+                CuckooHashMap *cu = cuckoo_create_with(capacity, &opts);
+                
+                double start = get_time_ms();
+                for (int i = 0; i < n; i++) {
+                    cuckoo_put(cu, keys[i], i);
+                }
+                total_ms += get_time_ms() - start;
+                rehashes += cuckoo_rehash_count(cu);
+                stashed += cu->stash_count;
+                
+                cuckoo_destroy(cu);
+                free(keys);
+            }
+            printf("%-6.2f | %-8d | %10d | %10d | %9.3f ms\n", loads[l],
+                   stash_sizes[s] < 0 ? 0 : stash_sizes[s], rehashes, stashed,
+                   total_ms / trials);
+        }
+    }
+    printf("(totals over %d trials, %zu slots per table)\n", trials, capacity);
+}
+
+// Compare 2, 3 and 4 way cuckoo maps over the same number of slots
+// More ways trade an extra probe per lookup for much higher safe load
+void benchmark_cuckoo_ways(void) {
+    print_section_header("D-ARY CUCKOO (2, 3, 4 WAYS)");
+    
+    // Each configuration gets the same total slot count
+    size_t slots = 3 * 4 * 20000;
+    // Loads below each d's threshold (~0.5, ~0.918, ~0.977)
+    static const struct { int ways; double load; } configs[] = {
+        {2, 0.45}, {3, 0.45}, {4, 0.45},
+        {3, 0.85}, {4, 0.85},
+        {3, 0.90}, {4, 0.90}, {4, 0.95}
+    };
+    int num_configs = sizeof(configs) / sizeof(configs[0]);
+    
+    printf("%-5s | %-6s | %-10s | %-12s | %-12s | %-8s\n", "Ways", "Load",
+           "Memory", "Insert", "Lookup", "Rehashes");
+    printf("------|--------|------------|--------------|--------------|---------\n");
+    
+    for (int c = 0; c < num_configs; c++) {
+        int ways = configs[c].ways;
+        int n = (int)(configs[c].load * slots);
+        int *keys = generate_random_keys(n);
+        
+        CuckooOptions opts = {0};
+        opts.seed = benchmark_seed();
+        opts.ways = ways;
+        opts.max_load = 0.99;  // Measure the target load, no growth
+        CuckooHashMap *cu = cuckoo_create_with(slots / ways, &opts);
+        
+        double start = get_time_ms();
+        for (int i = 0; i < n; i++) {
+            cuckoo_put(cu, keys[i], i);
+        }
+        double insert_ms = get_time_ms() - start;
+        
+        int value;
+        start = get_time_ms();
+        for (int i = 0; i < n; i++) {
+            cuckoo_get(cu, keys[i], &value);
+        }
+        double lookup_ms = get_time_ms() - start;
+        
+        printf("%-5d | %-6.2f | %7.1f KB | %9.3f ms | %9.3f ms | %8d\n", ways,
+               cuckoo_load_factor(cu), cuckoo_memory_usage(cu) / 1024.0,
+               insert_ms, lookup_ms, cuckoo_rehash_count(cu));
+        
+        cuckoo_destroy(cu);
+        free(keys);
+    }
+    printf("(%zu total slots; bytes per key = memory / (load * slots))\n", slots);
+}
+
+// Hash flooding: every key collides under the map's (leaked) seed
+// Without detection each insert walks the whole cluster, O(n) per op;
+// with it the first long chain reseeds and per-op cost stays flat
+void benchmark_adversarial(void) {
+    print_section_header("HASH FLOODING (COLLIDING KEYS)");
+    
+    int sizes[] = {1000, 4000, 16000};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    
+    printf("%-7s | %-8s | %-9s | %-13s | %-13s | %-7s | %-8s\n", "Map",
+           "Keys", "Detection", "Insert/op", "Lookup/op", "Reseeds",
+           "Max scan");
+    printf("--------|----------|-----------|---------------|"
+           "---------------|---------|---------\n");
+    
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        size_t capacity = (size_t)n * 2;
+        int val;
+        
+        for (int protect = 0; protect <= 1; protect++) {
+            // Chained: attacker crafts keys for the seed the map drew
+            ChainedOptions copts = {0};
+            copts.seed = benchmark_seed();
+            copts.max_chain = protect ? 0 : SIZE_MAX;
+            ChainedHashMap *ch = chained_create_with(capacity, &copts);
+            int *keys = generate_colliding_keys(n, ch->seed, capacity);
+            
+            double start = get_time_ms();
+            for (int i = 0; i < n; i++) {
+                chained_put(ch, keys[i], i);
+            }
+            double insert_ms = get_time_ms() - start;
+            start = get_time_ms();
+            for (int i = 0; i < n; i++) {
+                chained_get(ch, keys[i], &val);
+            }
+            double lookup_ms = get_time_ms() - start;
+            printf("%-7s | %-8d | %-9s | %10.3f us | %10.3f us | %7d | %8d\n",
+                   "Chained", n, protect ? "on" : "off",
+                   insert_ms * 1000.0 / n, lookup_ms * 1000.0 / n,
+                   chained_reseed_count(ch), chained_max_chain_length(ch));
+            chained_destroy(ch);
+            free(keys);
+            
+            // Linear probing under the same attack
+            LinearOptions lopts = {0};
+            lopts.seed = benchmark_seed();
+            lopts.max_probes = protect ? 0 : SIZE_MAX;
+            LinearHashMap *lh = linear_create_with(capacity, &lopts);
+            keys = generate_colliding_keys(n, lh->seed, capacity);
+            
+            start = get_time_ms();
+            for (int i = 0; i < n; i++) {
+                linear_put(lh, keys[i], i);
+            }
+            insert_ms = get_time_ms() - start;
+            int max_probes = 0;
+            start = get_time_ms();
+            for (int i = 0; i < n; i++) {
+                linear_get(lh, keys[i], &val);
+            }
+            lookup_ms = get_time_ms() - start;
+            for (int i = 0; i < n; i++) {
+                int probes = linear_probe_count(lh, keys[i]);
+                if (probes > max_probes) max_probes = probes;
+            }
+            printf("%-7s | %-8d | %-9s | %10.3f us | %10.3f us | %7d | %8d\n",
+                   "Linear", n, protect ? "on" : "off",
+                   insert_ms * 1000.0 / n, lookup_ms * 1000.0 / n,
+                   linear_reseed_count(lh), max_probes);
+            linear_destroy(lh);
+            free(keys);
+        }
+    }
+    printf("(Max scan: longest chain / most probes for a stored key)\n");
+}
+
+// Hash throughput of each SIMD level, then single-key vs batch lookups
+void benchmark_hash_simd(void) {
+    print_section_header("VECTORIZED HASHING");
+    
+    int n = 1 << 20;  // 4 MB of keys, stays mostly in cache
+    int reps = 20;
+    int *keys = generate_random_keys(n);
+    unsigned int *out = malloc((size_t)n * sizeof(unsigned int));
+    
+    printf("Best level on this CPU: %s\n\n", hash_simd_name(hash_simd_best()));
+    printf("%-8s | %-14s | %-8s\n", "Level", "Mhashes/sec", "Speedup");
+    printf("---------|----------------|---------\n");
+    double scalar_rate = 0;
+    for (int level = HASH_SIMD_SCALAR; level <= (int)hash_simd_best(); level++) {
+        double start = get_time_ms();
+        for (int r = 0; r < reps; r++) {
+            hash_batch_with((HashSimdLevel)level, keys, (unsigned int)r, out, n);
+        }
+        double ms = get_time_ms() - start;
+        double rate = (double)n * reps / (ms * 1000.0);  // Millions per second
+        if (level == HASH_SIMD_SCALAR) scalar_rate = rate;
+        printf("%-8s | %14.1f | %7.2fx\n", hash_simd_name((HashSimdLevel)level),
+               rate, rate / scalar_rate);
+    }
+    
+    // Lookups with the hash done per key vs HASH_BATCH keys at a time
+    int m = 200000;
+    size_t capacity = (size_t)m * 2;
+    int *values = malloc((size_t)m * sizeof(int));
+    for (int i = 0; i < m; i++) values[i] = i;
+    ChainedHashMap *ch = chained_create(capacity);
+    LinearHashMap *lh = linear_create(capacity);
+    CuckooHashMap *cu = bench_cuckoo_create(capacity);
+    chained_put_batch(ch, keys, values, m);
+    linear_put_batch(lh, keys, values, m);
+    cuckoo_put_batch(cu, keys, values, m);
+    
+    printf("\n%-8s | %-12s | %-12s\n", "Map", "Single get", "Batch get");
+    printf("---------|--------------|-------------\n");
+    int val;
+    double start = get_time_ms();
+    for (int i = 0; i < m; i++) chained_get(ch, keys[i], &val);
+    double single_ms = get_time_ms() - start;
+    start = get_time_ms();
+    chained_get_batch(ch, keys, values, NULL, m);
+    printf("%-8s | %9.3f ms | %9.3f ms\n", "Chained", single_ms,
+           get_time_ms() - start);
+    
+    start = get_time_ms();
+    for (int i = 0; i < m; i++) linear_get(lh, keys[i], &val);
+    single_ms = get_time_ms() - start;
+    start = get_time_ms();
+    linear_get_batch(lh, keys, values, NULL, m);
+    printf("%-8s | %9.3f ms | %9.3f ms\n", "Linear", single_ms,
+           get_time_ms() - start);
+    
+    start = get_time_ms();
+    for (int i = 0; i < m; i++) cuckoo_get(cu, keys[i], &val);
+    single_ms = get_time_ms() - start;
+    start = get_time_ms();
+    cuckoo_get_batch(cu, keys, values, NULL, m);
+    printf("%-8s | %9.3f ms | %9.3f ms\n", "Cuckoo", single_ms,
+           get_time_ms() - start);
+    
+    chained_destroy(ch);
+    linear_destroy(lh);
+    cuckoo_destroy(cu);
+    free(values);
+    free(out);
+    free(keys);
+}
+
+// Time the lookup loop of one map, best of TEMPLATE_REPS runs
+#define TEMPLATE_REPS 5
+#define TIME_LOOKUPS(best, get_call)                          \
+    do {                                                      \
+        (best) = 0;                                           \
+        for (int rep = 0; rep < TEMPLATE_REPS; rep++) {       \
+            double t0 = get_time_ms();                        \
+            for (int i = 0; i < n; i++) get_call;             \
+            double t = get_time_ms() - t0;                    \
+            if (rep == 0 || t < (best)) (best) = t;           \
+        }                                                     \
+    } while (0)
+
+// Hand-written maps vs their DEFINE_*_MAP int instantiation
+// Same hash and algorithm, so the gap is what call-site inlining buys
+void benchmark_templates(int n) {
+    print_section_header("TEMPLATE MAPS VS HAND-WRITTEN (int -> int)");
+    
+    int *keys = generate_random_keys(n);
+    size_t capacity = (size_t)n * 2;
+    int val;
+    
+    ChainedHashMap *ch = chained_create(capacity);
+    IntChained *tch = IntChained_create(capacity);
+    LinearHashMap *lh = linear_create(capacity);
+    IntLinear *tlh = IntLinear_create(capacity);
+    CuckooHashMap *cu = bench_cuckoo_create(capacity);
+    IntCuckoo *tcu = IntCuckoo_create(capacity);
+    for (int i = 0; i < n; i++) {
+        chained_put(ch, keys[i], i);
+        IntChained_put(tch, keys[i], i);
+        linear_put(lh, keys[i], i);
+        IntLinear_put(tlh, keys[i], i);
+        cuckoo_put(cu, keys[i], i);
+        IntCuckoo_put(tcu, keys[i], i);
+    }
+    
+    printf("%-8s | %-12s | %-12s | %-7s\n", "Map", "Original", "Template",
+           "Ratio");
+    printf("---------|--------------|--------------|--------\n");
+    double orig, tmpl;
+    TIME_LOOKUPS(orig, chained_get(ch, keys[i], &val));
+    TIME_LOOKUPS(tmpl, IntChained_get(tch, keys[i], &val));
+    printf("%-8s | %9.3f ms | %9.3f ms | %6.2fx\n", "Chained", orig, tmpl,
+           orig / tmpl);
+    TIME_LOOKUPS(orig, linear_get(lh, keys[i], &val));
+    TIME_LOOKUPS(tmpl, IntLinear_get(tlh, keys[i], &val));
+    printf("%-8s | %9.3f ms | %9.3f ms | %6.2fx\n", "Linear", orig, tmpl,
+           orig / tmpl);
+    TIME_LOOKUPS(orig, cuckoo_get(cu, keys[i], &val));
+    TIME_LOOKUPS(tmpl, IntCuckoo_get(tcu, keys[i], &val));
+    printf("%-8s | %9.3f ms | %9.3f ms | %6.2fx\n", "Cuckoo", orig, tmpl,
+           orig / tmpl);
+    printf("(%d lookups, best of %d; ratio > 1 means the template is faster)\n",
+           n, TEMPLATE_REPS);
+    
+    chained_destroy(ch);
+    IntChained_destroy(tch);
+    linear_destroy(lh);
+    IntLinear_destroy(tlh);
+    cuckoo_destroy(cu);
+    IntCuckoo_destroy(tcu);
+    free(keys);
+}
+
+// Memory hierarchy sweep settings
+#define SWEEP_LOAD 0.5                  // Keys per slot for every map
+#define SWEEP_MIN_BYTES (16 * 1024)     // Smallest table, well inside L1
+#define SWEEP_BYTES_PER_KEY 48          // Upper bound (chained, malloc overhead)
+#define SWEEP_MIN_OPS 2000000           // Ops per data point, via repetition
+
+// Measure one map at one size: insert, hit, miss and delete ns/op averaged
+// over reps fresh builds, then emit a CSV row (and a table row if the CSV
+// goes to a file). Expands inside benchmark_memory_sweep
+#define SWEEP_MAP(label, Type, create, put, get, del, mem, destroy)           \
+    do {                                                                      \
+        double ns[4] = {0, 0, 0, 0};                                          \
+        size_t bytes = 0;                                                     \
+        for (int rep = 0; rep < reps; rep++) {                                \
+            Type *m = create;                                                 \
+            double t0 = get_time_ns();                                        \
+            for (int i = 0; i < n; i++) put(m, keys[i], i);                   \
+            double t1 = get_time_ns();                                        \
+            for (int i = 0; i < n; i++) get(m, keys[i], &val);                \
+            double t2 = get_time_ns();                                        \
+            for (int i = 0; i < n; i++) get(m, misses[i], &val);              \
+            double t3 = get_time_ns();                                        \
+            bytes = mem(m);  /* Full table, before deletes shrink it */      \
+            for (int i = 0; i < n; i++) del(m, keys[i]);                      \
+            double t4 = get_time_ns();                                        \
+            ns[0] += t1 - t0;                                                 \
+            ns[1] += t2 - t1;                                                 \
+            ns[2] += t3 - t2;                                                 \
+            ns[3] += t4 - t3;                                                 \
+            destroy(m);                                                       \
+        }                                                                     \
+        double ops = (double)n * reps;                                        \
+        fprintf(csv, "%s,%d,%zu,%.2f,%.2f,%.2f,%.2f\n", label, n, bytes,      \
+                ns[0] / ops, ns[1] / ops, ns[2] / ops, ns[3] / ops);          \
+        if (csv != stdout) {                                                  \
+            printf("%-9s | %10d | %9.2f MB | %8.1f | %8.1f | %8.1f | %8.1f\n", \
+                   label, n, bytes / (1024.0 * 1024.0), ns[0] / ops,          \
+                   ns[1] / ops, ns[2] / ops, ns[3] / ops);                    \
+        }                                                                     \
+    } while (0)
+
+// Sweep table sizes from L1 resident to max_mb (log spaced, x2 per step)
+// at a fixed load factor and report ns/op for each operation and map.
+// Rows are CSV (map,keys,bytes,insert_ns,hit_ns,miss_ns,delete_ns) for
+// plotting ns/op against bytes; written to csv_path, or stdout if NULL
+void benchmark_memory_sweep(size_t max_mb, const char *csv_path) {
+    print_section_header("MEMORY HIERARCHY SWEEP");
+    
+    FILE *csv = stdout;
+    if (csv_path) {
+        csv = fopen(csv_path, "w");
+        if (!csv) {
+            printf("Cannot open %s for writing\n", csv_path);
+            return;
+        }
+    }
+    
+    // Smallest point: the linear table (2 slots per key) fills SWEEP_MIN_BYTES
+    size_t max_bytes = max_mb * 1024 * 1024;
+    int first = (int)(SWEEP_MIN_BYTES * SWEEP_LOAD / sizeof(LinearEntry));
+    
+    fprintf(csv, "map,keys,bytes,insert_ns,hit_ns,miss_ns,delete_ns\n");
+    if (csv != stdout) {
+        printf("Load %.2f, writing CSV to %s\n\n", SWEEP_LOAD, csv_path);
+        printf("%-9s | %-10s | %-12s | %-8s | %-8s | %-8s | %-8s\n", "Map",
+               "Keys", "Memory", "Ins ns", "Hit ns", "Miss ns", "Del ns");
+        printf("----------|------------|--------------|----------|----------|"
+               "----------|---------\n");
+    }
+    
+    for (int n = first;
+         (size_t)n * SWEEP_BYTES_PER_KEY <= max_bytes && n <= (1 << 29);
+         n *= 2) {
+        // Disjoint counter ranges: every miss key is absent
+        int *keys = generate_distinct_keys(n, 0);
+        int *misses = generate_distinct_keys(n, (unsigned int)n);
+        if (!keys || !misses) {
+            free(keys);
+            free(misses);
+            printf("Out of memory at %d keys\n", n);
+            break;
+        }
+        size_t slots = (size_t)(n / SWEEP_LOAD);
+        int reps = n < SWEEP_MIN_OPS ? SWEEP_MIN_OPS / n : 1;
+        int val;
+        
+        SWEEP_MAP("chained", ChainedHashMap, chained_create(slots),
+                  chained_put, chained_get, chained_delete,
+                  chained_memory_usage, chained_destroy);
+        SWEEP_MAP("linear", LinearHashMap, linear_create(slots),
+                  linear_put, linear_get, linear_delete,
+                  linear_memory_usage, linear_destroy);
+        // Two tables of slots / 2 each: same total slots and load
+        SWEEP_MAP("cuckoo", CuckooHashMap, bench_cuckoo_create(slots / 2),
+                  cuckoo_put, cuckoo_get, cuckoo_delete,
+                  cuckoo_memory_usage, cuckoo_destroy);
+        SWEEP_MAP("hopscotch", HopscotchHashMap, hopscotch_create(slots),
+                  hopscotch_put, hopscotch_get, hopscotch_delete,
+                  hopscotch_memory_usage, hopscotch_destroy);
+        fflush(csv);
         
         free(keys);
+        free(misses);
     }
+    
+    if (csv != stdout) fclose(csv);
+}
+
+// Lookups each thread performs per measurement
+#define THREAD_LOOKUPS 1000000
+
+// Read-only lookup shared by every map under test
+typedef bool (*LookupFn)(void *map, int key, int *value);
+
+static bool lookup_chained(void *map, int key, int *value) {
+    return chained_get(map, key, value);
+}
+static bool lookup_linear(void *map, int key, int *value) {
+    return linear_get(map, key, value);
+}
+static bool lookup_cuckoo(void *map, int key, int *value) {
+    return cuckoo_get(map, key, value);
+}
+static bool lookup_hopscotch(void *map, int key, int *value) {
+    return hopscotch_get(map, key, value);
+}
+static bool lookup_frozen(void *map, int key, int *value) {
+    return frozen_get(map, key, value);
+}
+static bool lookup_linear_soa(void *map, int key, int *value) {
+    return linear_soa_get(map, key, value);
+}
+static bool lookup_chained_unrolled(void *map, int key, int *value) {
+    return chained_unrolled_get(map, key, value);
+}
+static bool lookup_cuckoo_filter(void *map, int key, int *value) {
+    (void)value;  // A filter stores no values
+    return cuckoo_filter_contains(map, key);
+}
+
+// Work and result of one lookup thread
+typedef struct {
+    LookupFn get;
+    void *map;
+    const int *stream;  // This thread's keys, THREAD_LOOKUPS of them
+    double ns;          // Elapsed time, set by the worker
+    int found;          // Hits, also keeps the loop from being optimized out
+} LookupThread;
+
+// Thread body: run the whole key stream against the shared map
+static void lookup_worker(void *arg) {
+    LookupThread *w = arg;
+    int val;
+    int found = 0;
+    double start = get_time_ns();
+    for (int i = 0; i < THREAD_LOOKUPS; i++) {
+        if (w->get(w->map, w->stream[i], &val)) found++;
+    }
+    w->ns = get_time_ns() - start;
+    w->found = found;
+}
+
+// Build one key stream per thread: hit_pct percent of lookups come from
+// the thread's own slice of the stored keys, the rest from a miss range
+// no other thread uses, in random order so hit/miss is not predictable
+static int* build_lookup_streams(const int *keys, int n, int threads,
+                                 int hit_pct) {
+    int *streams = malloc((size_t)threads * THREAD_LOOKUPS * sizeof(int));
+    if (!streams) return NULL;
+    
+    int slice = n / threads > 0 ? n / threads : 1;
+    for (int t = 0; t < threads; t++) {
+        int *s = streams + (size_t)t * THREAD_LOOKUPS;
+        int *misses = generate_distinct_keys(THREAD_LOOKUPS,
+            (unsigned int)n + (unsigned int)t * THREAD_LOOKUPS);
+        if (!misses) {
+            free(streams);
+            return NULL;
+        }
+        Prng rng;
+        prng_seed(&rng, (uint64_t)t + 1);
+        int base = (t * slice) % n;
+        for (int i = 0; i < THREAD_LOOKUPS; i++) {
+            if ((int)(prng_next(&rng) % 100) < hit_pct) {
+                s[i] = keys[base + (int)(prng_next(&rng) % (uint64_t)slice)];
+            } else {
+                s[i] = misses[i];
+            }
+        }
+        free(misses);
+    }
+    return streams;
+}
+
+// One map under test in benchmark_threaded_lookups
+typedef struct {
+    const char *name;
+    LookupFn get;
+    void *map;
+} LookupTarget;
+
+// Time every target with 1, 2, 4 .. max_threads threads for one key mix
+static void run_lookup_mix(const LookupTarget *targets, size_t count,
+                           const int *keys, int n, int max_threads,
+                           const char *mix, int hit_pct) {
+    int *streams = build_lookup_streams(keys, n, max_threads, hit_pct);
+    LookupThread *work = malloc((size_t)max_threads * sizeof(LookupThread));
+    if (!streams || !work) {
+        printf("Out of memory\n");
+        free(streams);
+        free(work);
+        return;
+    }
+    
+    char title[64];
+    snprintf(title, sizeof(title), "%s (%d%% hits)", mix, hit_pct);
+    print_subsection(title);
+    printf("%-10s | %-7s | %-10s | %-12s | %-7s\n", "Map", "Threads",
+           "Mops/s", "ns/op/thread", "Speedup");
+    printf("-----------|---------|------------|--------------|--------\n");
+    
+    for (size_t k = 0; k < count; k++) {
+        double single = 0.0;
+        // Powers of two, then max_threads itself if it is not one
+        for (int t = 1; t <= max_threads;
+             t = (t * 2 > max_threads && t < max_threads) ? max_threads : t * 2) {
+            for (int i = 0; i < t; i++) {
+                work[i].get = targets[k].get;
+                work[i].map = targets[k].map;
+                work[i].stream = streams + (size_t)i * THREAD_LOOKUPS;
+            }
+            if (!run_pinned_threads(t, lookup_worker, work,
+                                    sizeof(LookupThread))) {
+                printf("Could not start %d threads\n", t);
+                break;
+            }
+            
+            double slowest = 0.0, total_ns = 0.0;
+            for (int i = 0; i < t; i++) {
+                if (work[i].ns > slowest) slowest = work[i].ns;
+                total_ns += work[i].ns;
+            }
+            double mops = (double)t * THREAD_LOOKUPS / slowest * 1000.0;
+            if (t == 1) single = mops;
+            printf("%-10s | %7d | %10.1f | %12.1f | %6.2fx\n",
+                   targets[k].name, t, mops,
+                   total_ns / ((double)t * THREAD_LOOKUPS), mops / single);
+        }
+    }
+    free(streams);
+    free(work);
+}
+
+// Read-only lookup scaling: each map is built once with n keys, then
+// 1, 2, 4 .. max_threads pinned threads query it concurrently with
+// disjoint key streams. Reports aggregate Mops/s (total lookups over the
+// slowest thread's time) and the average ns/op seen by each thread.
+// Built with HASHMAP_STATS the shared counters race, so expect lower
+// throughput and approximate counts there
+void benchmark_threaded_lookups(int n, int max_threads) {
+    print_section_header("MULTI-THREADED LOOKUP THROUGHPUT");
+    
+    if (n < 1) n = 1;
+    if (max_threads < 1) max_threads = 1;
+    if (max_threads > MAX_BENCH_THREADS) max_threads = MAX_BENCH_THREADS;
+    printf("%d keys, %d lookups per thread, %d CPUs online\n\n", n,
+           THREAD_LOOKUPS, thread_cpu_count());
+    
+    int *keys = generate_distinct_keys(n, 0);
+    size_t capacity = (size_t)n * 2;
+    ChainedHashMap *ch = chained_create(capacity);
+    LinearHashMap *lp = linear_create(capacity);
+    CuckooHashMap *cu = bench_cuckoo_create(capacity);
+    HopscotchHashMap *hs = hopscotch_create(capacity);
+    
+    if (keys && ch && lp && cu && hs) {
+        for (int i = 0; i < n; i++) {
+            chained_put(ch, keys[i], i);
+            linear_put(lp, keys[i], i);
+            cuckoo_put(cu, keys[i], i);
+            hopscotch_put(hs, keys[i], i);
+        }
+        
+        LookupTarget targets[] = {
+            {"Chained", lookup_chained, ch},
+            {"Linear", lookup_linear, lp},
+            {"Cuckoo", lookup_cuckoo, cu},
+            {"Hopscotch", lookup_hopscotch, hs},
+        };
+        size_t count = sizeof(targets) / sizeof(targets[0]);
+        run_lookup_mix(targets, count, keys, n, max_threads, "hit-heavy", 90);
+        run_lookup_mix(targets, count, keys, n, max_threads, "miss-heavy", 10);
+    } else {
+        printf("Out of memory\n");
+    }
+    
+    chained_destroy(ch);
+    linear_destroy(lp);
+    cuckoo_destroy(cu);
+    hopscotch_destroy(hs);
+    free(keys);
+}
+
+// Wall time of one resize of each map moving n keys with 1, 2, 4 ..
+// max_threads migration threads. Every map is built once per thread
+// count with the same keys; only the resize call is timed:
+// chained n / 4 -> n buckets, linear 2n -> 4n slots, cuckoo grows 2x
+void benchmark_parallel_resize(int n, int max_threads) {
+    print_section_header("PARALLEL RESIZE (WALL TIME VS THREADS)");
+    
+    if (n < 1) n = 1;
+    if (max_threads < 1) max_threads = 1;
+    printf("%d keys, %d CPUs online, tables under %d entries stay serial\n\n",
+           n, thread_cpu_count(), PARALLEL_MIN_ITEMS);
+    int *keys = generate_distinct_keys(n, 0);
+    if (!keys) {
+        printf("Out of memory\n");
+        return;
+    }
+    
+    printf("%-7s | %-10s | %-7s | %-10s | %-7s | %-10s | %-7s\n", "Threads",
+           "Chained ms", "Speedup", "Linear ms", "Speedup", "Cuckoo ms",
+           "Speedup");
+    printf("--------|------------|---------|------------|---------|"
+           "------------|--------\n");
+    double base[3] = {0, 0, 0};
+    // Powers of two, then max_threads itself if it is not one
+    for (int t = 1; t <= max_threads;
+         t = (t * 2 > max_threads && t < max_threads) ? max_threads : t * 2) {
+        double ms[3] = {-1, -1, -1};  // Negative: allocation failed
+        
+        ChainedOptions copts = {0};
+        copts.seed = benchmark_seed();
+        copts.resize_threads = t;
+        ChainedHashMap *ch = chained_create_with((size_t)n / 4 + 1, &copts);
+        if (ch) {
+            for (int i = 0; i < n; i++) chained_put(ch, keys[i], i);
+            double start = get_time_ns();
+            if (chained_resize(ch, (size_t)n)) ms[0] = (get_time_ns() - start) / 1e6;
+            chained_destroy(ch);
+        }
+        
+        LinearOptions lopts = {0};
+        lopts.seed = benchmark_seed();
+        lopts.resize_threads = t;
+        LinearHashMap *lp = linear_create_with((size_t)n * 2, &lopts);
+        if (lp) {
+            for (int i = 0; i < n; i++) linear_put(lp, keys[i], i);
+            double start = get_time_ns();
+            if (linear_resize(lp, (size_t)n * 4)) ms[1] = (get_time_ns() - start) / 1e6;
+            linear_destroy(lp);
+        }
+        
+        CuckooOptions cuopts = {0};
+        cuopts.seed = benchmark_seed();
+        cuopts.resize_threads = t;
+        CuckooHashMap *cu = cuckoo_create_with((size_t)n * 5 / 4 + 1, &cuopts);
+        if (cu) {
+            for (int i = 0; i < n; i++) cuckoo_put(cu, keys[i], i);
+            double start = get_time_ns();
+            if (cuckoo_resize(cu, cu->capacity * 2)) ms[2] = (get_time_ns() - start) / 1e6;
+            cuckoo_destroy(cu);
+        }
+        
+        if (t == 1) memcpy(base, ms, sizeof(base));
+        printf("%7d", t);
+        for (int k = 0; k < 3; k++) {
+            if (ms[k] < 0) {
+                printf(" | %10s | %7s", "failed", "-");
+            } else {
+                printf(" | %10.2f | %6.2fx", ms[k], ms[k] > 0 ? base[k] / ms[k] : 0.0);
+            }
+        }
+        printf("\n");
+    }
+    free(keys);
+}
+
+// Lookup rounds averaged by benchmark_frozen
+#define FROZEN_REPS 5
+
+// Average ns per lookup of n keys over FROZEN_REPS rounds
+static double time_lookup_ns(LookupFn get, void *map, const int *keys, int n) {
+    int val;
+    volatile int found = 0;  // Keeps the lookups from being optimized out
+    double start = get_time_ns();
+    for (int r = 0; r < FROZEN_REPS; r++) {
+        for (int i = 0; i < n; i++) {
+            if (get(map, keys[i], &val)) found++;
+        }
+    }
+    return (get_time_ns() - start) / ((double)n * FROZEN_REPS);
+}
+
+// Print one row of benchmark_frozen
+static void print_frozen_row(const char *name, double build_ms, LookupFn get,
+                             void *map, const int *hits, const int *misses,
+                             int n, size_t bytes) {
+    printf("%-16s | %10.2f | %8.1f | %8.1f | %10.1f | %8.2f\n", name,
+           build_ms, time_lookup_ns(get, map, hits, n),
+           time_lookup_ns(get, map, misses, n), bytes / 1024.0,
+           (double)bytes / n);
+}
+
+// Build-once, read-many: compare each mutable map with its frozen copy
+// (minimal perfect hash, one entry per key). Build time of a frozen map
+// is the time *_freeze takes on the populated map
+void benchmark_frozen(int n) {
+    print_section_header("FROZEN MAPS (MINIMAL PERFECT HASH)");
+    
+    if (n < 1) n = 1;
+    int *keys = generate_distinct_keys(n, 0);
+    int *misses = generate_distinct_keys(n, (unsigned int)n);
+    if (!keys || !misses) {
+        free(keys);
+        free(misses);
+        return;
+    }
+    size_t capacity = (size_t)n * 2;
+    
+    printf("%d keys, %d lookup rounds\n\n", n, FROZEN_REPS);
+    printf("%-16s | %-10s | %-8s | %-8s | %-10s | %-8s\n", "Structure",
+           "Build ms", "Hit ns", "Miss ns", "Memory KB", "B/key");
+    printf("-----------------|------------|----------|----------|"
+           "------------|---------\n");
+    
+    double start = get_time_ms();
+    ChainedHashMap *ch = chained_create(capacity);
+    for (int i = 0; i < n; i++) chained_put(ch, keys[i], i);
+    double ch_ms = get_time_ms() - start;
+    start = get_time_ms();
+    FrozenMap *ch_frozen = chained_freeze(ch);
+    double ch_frozen_ms = get_time_ms() - start;
+    
+    start = get_time_ms();
+    LinearHashMap *lp = linear_create(capacity);
+    for (int i = 0; i < n; i++) linear_put(lp, keys[i], i);
+    double lp_ms = get_time_ms() - start;
+    start = get_time_ms();
+    FrozenMap *lp_frozen = linear_freeze(lp);
+    double lp_frozen_ms = get_time_ms() - start;
+    
+    start = get_time_ms();
+    CuckooHashMap *cu = bench_cuckoo_create(capacity);
+    for (int i = 0; i < n; i++) cuckoo_put(cu, keys[i], i);
+    double cu_ms = get_time_ms() - start;
+    start = get_time_ms();
+    FrozenMap *cu_frozen = cuckoo_freeze(cu);
+    double cu_frozen_ms = get_time_ms() - start;
+    
+    if (ch && lp && cu && ch_frozen && lp_frozen && cu_frozen) {
+        print_frozen_row("Chained", ch_ms, lookup_chained, ch, keys, misses,
+                         n, chained_memory_usage(ch));
+        print_frozen_row("Chained frozen", ch_frozen_ms, lookup_frozen,
+                         ch_frozen, keys, misses, n,
+                         frozen_memory_usage(ch_frozen));
+        print_frozen_row("Linear", lp_ms, lookup_linear, lp, keys, misses,
+                         n, linear_memory_usage(lp));
+        print_frozen_row("Linear frozen", lp_frozen_ms, lookup_frozen,
+                         lp_frozen, keys, misses, n,
+                         frozen_memory_usage(lp_frozen));
+        print_frozen_row("Cuckoo", cu_ms, lookup_cuckoo, cu, keys, misses,
+                         n, cuckoo_memory_usage(cu));
+        print_frozen_row("Cuckoo frozen", cu_frozen_ms, lookup_frozen,
+                         cu_frozen, keys, misses, n,
+                         frozen_memory_usage(cu_frozen));
+    } else {
+        printf("Out of memory\n");
+    }
+    
+    chained_destroy(ch);
+    linear_destroy(lp);
+    cuckoo_destroy(cu);
+    frozen_destroy(ch_frozen);
+    frozen_destroy(lp_frozen);
+    frozen_destroy(cu_frozen);
+    free(keys);
+    free(misses);
+}
+
+// Cache benchmark workload: requests drawn from a Zipf key universe
+#define CACHE_UNIVERSE 100000
+#define CACHE_REQUESTS 2000000
+
+// Replay a request stream against a cache: hits are served, misses are
+// inserted (evicting when full). Prints hit ratio and throughput
+#define CACHE_RUN(label, policy, map, get, put, evictions, mem)               \
+    do {                                                                      \
+        int hits = 0, val;                                                    \
+        double t0 = get_time_ns();                                            \
+        for (int i = 0; i < CACHE_REQUESTS; i++) {                            \
+            if (get(map, stream[i], &val)) hits++;                            \
+            else put(map, stream[i], i);                                      \
+        }                                                                     \
+        double ns = get_time_ns() - t0;                                       \
+        printf("%-7s | %-11s | %8.2f%% | %8.1f | %10zu | %9.1f\n", label,     \
+               cache_policy_name(policy), 100.0 * hits / CACHE_REQUESTS,      \
+               CACHE_REQUESTS / ns * 1000.0, evictions(map),                 \
+               mem(map) / 1024.0);                                            \
+    } while (0)
+
+// Bounded cache mode under Zipfian requests: hit ratio and throughput of
+// CLOCK and sampled LRU on the linear and cuckoo maps, sized to hold the
+// same number of keys (1% and 10% of the universe)
+void benchmark_cache(void) {
+    print_section_header("CACHE MODE (ZIPF REQUESTS)");
+    
+    const double skews[] = {0.8, 0.99, 1.2};
+    const int percents[] = {1, 10};
+    const CachePolicy policies[] = {CACHE_CLOCK, CACHE_SAMPLED_LRU};
+    
+    printf("%d requests over %d keys, misses insert the key\n",
+           CACHE_REQUESTS, CACHE_UNIVERSE);
+    for (size_t z = 0; z < sizeof(skews) / sizeof(skews[0]); z++) {
+        int *stream = generate_zipf_keys(CACHE_REQUESTS, CACHE_UNIVERSE,
+                                         skews[z]);
+        if (!stream) return;
+        
+        for (size_t c = 0; c < sizeof(percents) / sizeof(percents[0]); c++) {
+            size_t keys = (size_t)CACHE_UNIVERSE * percents[c] / 100;
+            char title[64];
+            snprintf(title, sizeof(title), "Zipf s=%.2f, cache holds %d%% (%zu keys)",
+                     skews[z], percents[c], keys);
+            print_subsection(title);
+            printf("%-7s | %-11s | %-9s | %-8s | %-10s | %-9s\n", "Map",
+                   "Policy", "Hit ratio", "Mops/s", "Evictions", "Memory KB");
+            printf("--------|-------------|-----------|----------|------------|"
+                   "----------\n");
+            
+            for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); p++) {
+                LinearOptions lopts = {0};
+                lopts.seed = benchmark_seed();
+                lopts.cache = policies[p];
+                LinearHashMap *lp = linear_create_with(
+                    (size_t)(keys / LINEAR_CACHE_MAX_LOAD) + 1, &lopts);
+                
+                CuckooOptions copts = {0};
+                copts.seed = benchmark_seed();
+                copts.cache = policies[p];
+                CuckooHashMap *cu = cuckoo_create_with(
+                    (size_t)(keys / (2 * 0.45)) + 1, &copts);  // 2 ways, default load
+                
+                if (lp) {
+                    CACHE_RUN("Linear", policies[p], lp, linear_get, linear_put,
+                              linear_evictions, linear_memory_usage);
+                }
+                if (cu) {
+                    CACHE_RUN("Cuckoo", policies[p], cu, cuckoo_get, cuckoo_put,
+                              cuckoo_evictions, cuckoo_memory_usage);
+                }
+                linear_destroy(lp);
+                cuckoo_destroy(cu);
+            }
+        }
+        free(stream);
+    }
+}
+
+// Word count workload: tokens drawn from a Zipf vocabulary (s = 1)
+#define WORD_VOCABULARY 50000
+#define WORD_REPS 3
+
+// Count every token twice on fresh maps, once with get + put and once
+// with add. Keeps the best of WORD_REPS runs and checks the counts agree
+#define WORD_COUNT_RUN(label, Type, create, destroy, get, put, add)          \
+    do {                                                                      \
+        double best_gp = 0, best_add = 0;                                     \
+        bool agree = true;                                                    \
+        for (int rep = 0; rep < WORD_REPS; rep++) {                           \
+            Type *a = create(capacity);                                       \
+            Type *b = create(capacity);                                       \
+            double t0 = get_time_ns();                                        \
+            for (int i = 0; i < n; i++) {                                     \
+                int count = 0;                                                \
+                get(a, tokens[i], &count);                                    \
+                put(a, tokens[i], count + 1);                                 \
+            }                                                                 \
+            double gp = get_time_ns() - t0;                                   \
+            t0 = get_time_ns();                                               \
+            for (int i = 0; i < n; i++) add(b, tokens[i], 1);                 \
+            double ad = get_time_ns() - t0;                                   \
+            if (rep == 0 || gp < best_gp) best_gp = gp;                       \
+            if (rep == 0 || ad < best_add) best_add = ad;                     \
+            for (int i = 0; i < n && agree; i++) {                            \
+                int ca = -1, cb = -2;                                         \
+                get(a, tokens[i], &ca);                                       \
+                get(b, tokens[i], &cb);                                       \
+                agree = ca == cb;                                             \
+            }                                                                 \
+            destroy(a);                                                       \
+            destroy(b);                                                       \
+        }                                                                     \
+        printf("%-8s | %10.1f | %8.1f | %6.2fx | %s\n", label, best_gp / n,  \
+               best_add / n, best_gp / best_add, agree ? "yes" : "NO");       \
+    } while (0)
+
+// Aggregation loop: count n Zipf-distributed tokens per map with a get
+// followed by a put (two probes per token) and with *_add (one probe)
+void benchmark_word_count(int n) {
+    print_section_header("WORD COUNT (GET + PUT VS ADD)");
+    
+    if (n < 1) n = 1;
+    int *tokens = generate_zipf_keys(n, WORD_VOCABULARY, 1.0);
+    if (!tokens) return;
+    size_t capacity = (size_t)WORD_VOCABULARY * 2;
+    
+    printf("%d tokens over %d words, best of %d\n\n", n, WORD_VOCABULARY,
+           WORD_REPS);
+    printf("%-8s | %-10s | %-8s | %-7s | %s\n", "Map", "get+put ns",
+           "add ns", "Speedup", "Same counts");
+    printf("---------|------------|----------|---------|------------\n");
+    WORD_COUNT_RUN("Chained", ChainedHashMap, chained_create, chained_destroy,
+                   chained_get, chained_put, chained_add);
+    WORD_COUNT_RUN("Linear", LinearHashMap, linear_create, linear_destroy,
+                   linear_get, linear_put, linear_add);
+    WORD_COUNT_RUN("Cuckoo", CuckooHashMap, bench_cuckoo_create, cuckoo_destroy,
+                   cuckoo_get, cuckoo_put, cuckoo_add);
+    free(tokens);
+}
+
+// Table size for benchmark_soa: both layouts are well past L2
+#define SOA_SLOTS (1 << 21)
+
+// Entry array (AoS, linear_probing.c) vs key / value / bitmap arrays
+// (SoA, linear_soa.c) for the same probing at high loads, where probe
+// sequences are long and the bytes each probe drags in matter most
+void benchmark_soa(void) {
+    print_section_header("LINEAR PROBING LAYOUT (AoS VS SoA)");
+    
+    const double loads[] = {0.5, 0.75, 0.9};
+    printf("%d slots, ns per lookup (average of %d rounds)\n\n", SOA_SLOTS,
+           FROZEN_REPS);
+    printf("%-5s | %-7s | %-7s | %-8s | %-8s | %-7s | %-7s\n", "Load",
+           "AoS hit", "SoA hit", "AoS miss", "SoA miss", "AoS MB", "SoA MB");
+    printf("------|---------|---------|----------|----------|---------|"
+           "--------\n");
+    
+    for (size_t l = 0; l < sizeof(loads) / sizeof(loads[0]); l++) {
+        int n = (int)(SOA_SLOTS * loads[l]);
+        int *keys = generate_distinct_keys(n, 0);
+        int *misses = generate_distinct_keys(n, (unsigned int)n);
+        LinearOptions opts = {0};
+        opts.seed = benchmark_seed();
+        LinearHashMap *aos = linear_create_with(SOA_SLOTS, &opts);
+        LinearSoaMap *soa = linear_soa_create(SOA_SLOTS);
+        if (!keys || !misses || !aos || !soa) {
+            printf("Out of memory\n");
+        } else {
+            for (int i = 0; i < n; i++) {
+                linear_put(aos, keys[i], i);
+                linear_soa_put(soa, keys[i], i);
+            }
+            printf("%4.0f%% | %7.1f | %7.1f | %8.1f | %8.1f | %7.1f | %7.1f\n",
+                   loads[l] * 100,
+                   time_lookup_ns(lookup_linear, aos, keys, n),
+                   time_lookup_ns(lookup_linear_soa, soa, keys, n),
+                   time_lookup_ns(lookup_linear, aos, misses, n),
+                   time_lookup_ns(lookup_linear_soa, soa, misses, n),
+                   linear_memory_usage(aos) / (1024.0 * 1024.0),
+                   linear_soa_memory_usage(soa) / (1024.0 * 1024.0));
+        }
+        linear_destroy(aos);
+        linear_soa_destroy(soa);
+        free(keys);
+        free(misses);
+    }
+}
+
+// Slot count for benchmark_probe_strategies (a power of two, so quadratic
+// and double hashing use the same table size as linear)
+#define PROBE_SLOTS (1 << 20)
+
+// Average probes over n keys, linear_probe_count for each
+static double average_probes(LinearHashMap *map, const int *keys, int n) {
+    size_t total = 0;
+    for (int i = 0; i < n; i++) total += (size_t)linear_probe_count(map, keys[i]);
+    return (double)total / n;
+}
+
+// Linear, quadratic and double hashing probe sequences in the same map,
+// with random and sequential keys: probe counts and ns per operation
+void benchmark_probe_strategies(void) {
+    print_section_header("PROBE STRATEGIES (LINEAR / QUADRATIC / DOUBLE)");
+    
+    const double loads[] = {0.5, 0.75, 0.9};
+    const ProbeStrategy strategies[] = {PROBE_LINEAR, PROBE_QUADRATIC,
+                                        PROBE_DOUBLE};
+    const char *names[] = {"Linear", "Quadratic", "Double"};
+    printf("%d slots, ns per operation (lookups average %d rounds)\n\n",
+           PROBE_SLOTS, FROZEN_REPS);
+    printf("%-10s | %-4s | %-9s | %-7s | %-7s | %-8s | %-6s | %-6s | %-7s\n",
+           "Keys", "Load", "Strategy", "Avg hit", "Max hit", "Avg miss",
+           "Put ns", "Hit ns", "Miss ns");
+    printf("-----------|------|-----------|---------|---------|----------|"
+           "--------|--------|--------\n");
+    
+    for (int seq = 0; seq < 2; seq++) {
+        for (size_t l = 0; l < sizeof(loads) / sizeof(loads[0]); l++) {
+            int n = (int)(PROBE_SLOTS * loads[l]);
+            // Sequential misses are the next n integers
+            int *all = seq ? generate_sequential_keys(2 * n) : NULL;
+            int *keys = seq ? all : generate_distinct_keys(n, 0);
+            int *misses = seq ? (all ? all + n : NULL)
+                              : generate_distinct_keys(n, (unsigned int)n);
+            for (int st = 0; st < 3; st++) {
+                LinearOptions opts = {0};
+                opts.seed = benchmark_seed();
+                opts.probe = strategies[st];
+                LinearHashMap *map = linear_create_with(PROBE_SLOTS, &opts);
+                if (!keys || !misses || !map) {
+                    printf("Out of memory\n");
+                    linear_destroy(map);
+                    continue;
+                }
+                double start = get_time_ns();
+                for (int i = 0; i < n; i++) linear_put(map, keys[i], i);
+                double put_ns = (get_time_ns() - start) / n;
+                size_t max_hit = linear_probe_histogram(map, NULL, NULL, 1);
+                printf("%-10s | %3.0f%% | %-9s | %7.2f | %7zu | %8.2f | %6.1f | "
+                       "%6.1f | %7.1f\n", seq ? "Sequential" : "Random",
+                       loads[l] * 100, names[st], average_probes(map, keys, n),
+                       max_hit, average_probes(map, misses, n), put_ns,
+                       time_lookup_ns(lookup_linear, map, keys, n),
+                       time_lookup_ns(lookup_linear, map, misses, n));
+                linear_destroy(map);
+            }
+            if (seq) {
+                free(all);
+            } else {
+                free(keys);
+                free(misses);
+            }
+        }
+    }
+}
+
+// Membership guard: cuckoo filters of several fingerprint sizes vs the
+// full CuckooHashMap holding the same n keys. Lookup rates are millions
+// per second; the false positive rate is measured on n absent keys
+void benchmark_cuckoo_filter(int n) {
+    print_section_header("CUCKOO FILTER VS CUCKOO MAP (MEMBERSHIP)");
+    
+    if (n < 1) n = 1;
+    int *keys = generate_distinct_keys(n, 0);
+    int *misses = generate_distinct_keys(n, (unsigned int)n);
+    if (!keys || !misses) {
+        free(keys);
+        free(misses);
+        return;
+    }
+    
+    printf("%d keys, %d lookup rounds\n\n", n, FROZEN_REPS);
+    printf("%-16s | %-8s | %-8s | %-9s | %-9s | %-9s | %-8s\n", "Structure",
+           "Build ms", "Hit M/s", "Miss M/s", "FPR", "Expected", "Bits/key");
+    printf("-----------------|----------|----------|-----------|-----------|"
+           "-----------|---------\n");
+    
+    CuckooOptions mopts = {0};
+    mopts.seed = benchmark_seed();
+    CuckooHashMap *map = cuckoo_create_with((size_t)n, &mopts);
+    if (map) {
+        double start = get_time_ns();
+        for (int i = 0; i < n; i++) cuckoo_put(map, keys[i], i);
+        double build_ms = (get_time_ns() - start) / 1e6;
+        printf("%-16s | %8.2f | %8.1f | %9.1f | %9.5f | %9.5f | %8.1f\n",
+               "Cuckoo map", build_ms,
+               1e3 / time_lookup_ns(lookup_cuckoo, map, keys, n),
+               1e3 / time_lookup_ns(lookup_cuckoo, map, misses, n), 0.0, 0.0,
+               cuckoo_memory_usage(map) * 8.0 / n);
+        cuckoo_destroy(map);
+    }
+    
+    const int bits[] = {8, 12, 16};
+    for (size_t b = 0; b < sizeof(bits) / sizeof(bits[0]); b++) {
+        CuckooFilterOptions fopts = {0};
+        fopts.fingerprint_bits = bits[b];
+        fopts.seed = benchmark_seed();
+        CuckooFilter *filter = cuckoo_filter_create_with((size_t)n, &fopts);
+        if (!filter) continue;
+        
+        double start = get_time_ns();
+        int stored = 0;
+        for (int i = 0; i < n; i++) {
+            if (cuckoo_filter_insert(filter, keys[i])) stored++;
+        }
+        double build_ms = (get_time_ns() - start) / 1e6;
+        int false_positives = 0;
+        for (int i = 0; i < n; i++) {
+            if (cuckoo_filter_contains(filter, misses[i])) false_positives++;
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "Filter %d-bit", bits[b]);
+        printf("%-16s | %8.2f | %8.1f | %9.1f | %9.5f | %9.5f | %8.1f\n", name,
+               build_ms, 1e3 / time_lookup_ns(lookup_cuckoo_filter, filter, keys, n),
+               1e3 / time_lookup_ns(lookup_cuckoo_filter, filter, misses, n),
+               (double)false_positives / n, cuckoo_filter_expected_fpr(filter),
+               cuckoo_filter_memory_usage(filter) * 8.0 / n);
+        if (stored < n) printf("  (filter full after %d keys)\n", stored);
+        cuckoo_filter_destroy(filter);
+    }
+    free(keys);
+    free(misses);
+}
+
+// Log file written and removed by benchmark_wal
+#define WAL_BENCH_PATH "benchmark_wal.log"
+
+// Puts timed when every record is its own commit (one fdatasync each)
+#define WAL_SYNC_OPS 2000
+
+// Commit policies compared by benchmark_wal
+typedef struct {
+    const char *name;
+    size_t commit_bytes;
+    double commit_ms;
+} WalPolicy;
+
+// Insert throughput with the log off and at several commit intervals,
+// then the time to replay the largest log into an empty map
+void benchmark_wal(int n) {
+    print_section_header("WRITE-AHEAD LOG (GROUP COMMIT)");
+    
+    if (n < 1) n = 1;
+    int *keys = generate_distinct_keys(n, 0);
+    if (!keys) return;
+    
+    const WalPolicy policies[] = {
+        {"Every record", WAL_RECORD_SIZE, -1},
+        {"4 KB", 4 * 1024, -1},
+        {"64 KB", 64 * 1024, -1},
+        {"1 MB", 1024 * 1024, -1},
+        {"1 ms", 1024 * 1024, 1.0},
+        {"10 ms", 1024 * 1024, 10.0},
+    };
+    
+    printf("%d puts into a chained map (%d when every record commits)\n\n",
+           n, n < WAL_SYNC_OPS ? n : WAL_SYNC_OPS);
+    printf("%-14s | %-8s | %-8s | %-8s | %-10s\n", "Commit", "Puts",
+           "Mops/s", "Commits", "Puts/sync");
+    printf("---------------|----------|----------|----------|-----------\n");
+    
+    ChainedHashMap *map = chained_create((size_t)n);
+    if (map) {
+        double start = get_time_ns();
+        for (int i = 0; i < n; i++) chained_put(map, keys[i], i);
+        double ns = get_time_ns() - start;
+        printf("%-14s | %8d | %8.2f | %8d | %10s\n", "No log", n, n * 1e3 / ns, 0, "-");
+        chained_destroy(map);
+    }
+    
+    for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); p++) {
+        int ops = policies[p].commit_bytes == WAL_RECORD_SIZE && n > WAL_SYNC_OPS
+                  ? WAL_SYNC_OPS : n;
+        WalOptions opts = {0};
+        opts.commit_bytes = policies[p].commit_bytes;
+        opts.commit_ms = policies[p].commit_ms;
+        remove(WAL_BENCH_PATH);
+        map = chained_create((size_t)n);
+        Wal *wal = map ? wal_open(WAL_BENCH_PATH, map, &wal_chained_ops, &opts) : NULL;
+        if (!wal) {
+            printf("%-14s | could not open %s\n", policies[p].name, WAL_BENCH_PATH);
+            chained_destroy(map);
+            continue;
+        }
+        
+        // The final commit is part of the cost: the puts are durable after it
+        double start = get_time_ns();
+        for (int i = 0; i < ops; i++) wal_put(wal, keys[i], i);
+        wal_commit(wal);
+        double ns = get_time_ns() - start;
+        size_t commits = wal_commit_count(wal);
+        printf("%-14s | %8d | %8.2f | %8zu | %10.1f\n", policies[p].name, ops,
+               ops * 1e3 / ns, commits, commits ? (double)ops / commits : 0.0);
+        wal_close(wal);
+        chained_destroy(map);
+    }
+    
+    // The last policy logged all n puts; rebuild a map from it
+    map = chained_create((size_t)n);
+    double start = get_time_ns();
+    Wal *wal = map ? wal_open(WAL_BENCH_PATH, map, &wal_chained_ops, NULL) : NULL;
+    double replay_ms = (get_time_ns() - start) / 1e6;
+    if (wal) {
+        printf("\nReplay of %zu records: %.2f ms (%.2f Mrecords/s), %zu keys\n",
+               wal_replay_count(wal), replay_ms,
+               wal_replay_count(wal) / (replay_ms * 1e3), chained_size(map));
+        wal_close(wal);
+    }
+    chained_destroy(map);
+    remove(WAL_BENCH_PATH);
+    free(keys);
+}
+
+// Bucket count for benchmark_unrolled; the load sets the key count
+#define UNROLLED_BUCKETS (1 << 18)
+
+// Fisher-Yates shuffle, so lookups do not follow allocation order
+static void shuffle_keys(int *keys, int n) {
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int t = keys[i];
+        keys[i] = keys[j];
+        keys[j] = t;
+    }
+}
+
+// One node per key (chained.c) vs 64-byte blocks of seven pairs
+// (chained_unrolled.c) as chains grow: lookup time, memory, allocations
+void benchmark_unrolled(void) {
+    print_section_header("CHAINED LAYOUT (NODES VS UNROLLED BLOCKS)");
+    
+    const int loads[] = {1, 2, 4, 8};
+    printf("%d buckets, ns per lookup (average of %d rounds)\n\n",
+           UNROLLED_BUCKETS, FROZEN_REPS);
+    printf("%-4s | %-8s | %-8s | %-9s | %-9s | %-8s | %-8s | %-7s\n", "Load",
+           "Node hit", "Unr. hit", "Node miss", "Unr. miss", "Node MB",
+           "Unr. MB", "Allocs");
+    printf("-----|----------|----------|-----------|-----------|----------|"
+           "----------|--------\n");
+    
+    for (size_t l = 0; l < sizeof(loads) / sizeof(loads[0]); l++) {
+        int n = UNROLLED_BUCKETS * loads[l];
+        int *keys = generate_distinct_keys(n, 0);
+        int *misses = generate_distinct_keys(n, (unsigned int)n);
+        ChainedOptions opts = {0};
+        opts.seed = benchmark_seed();
+        ChainedHashMap *nodes = chained_create_with(UNROLLED_BUCKETS, &opts);
+        ChainedUnrolledMap *unrolled = chained_unrolled_create(UNROLLED_BUCKETS);
+        if (!keys || !misses || !nodes || !unrolled) {
+            printf("Out of memory\n");
+        } else {
+            for (int i = 0; i < n; i++) {
+                chained_put(nodes, keys[i], i);
+                chained_unrolled_put(unrolled, keys[i], i);
+            }
+            // Nodes are malloc'd in insertion order: probe in another
+            shuffle_keys(keys, n);
+            // Allocs: node mallocs per block malloc
+            printf("%4d | %8.1f | %8.1f | %9.1f | %9.1f | %8.1f | %8.1f | %6.2fx\n",
+                   loads[l],
+                   time_lookup_ns(lookup_chained, nodes, keys, n),
+                   time_lookup_ns(lookup_chained_unrolled, unrolled, keys, n),
+                   time_lookup_ns(lookup_chained, nodes, misses, n),
+                   time_lookup_ns(lookup_chained_unrolled, unrolled, misses, n),
+                   chained_memory_usage(nodes) / (1024.0 * 1024.0),
+                   chained_unrolled_memory_usage(unrolled) / (1024.0 * 1024.0),
+                   (double)chained_size(nodes) /
+                   chained_unrolled_block_count(unrolled));
+        }
+        chained_destroy(nodes);
+        chained_unrolled_destroy(unrolled);
+        free(keys);
+        free(misses);
+    }
+    printf("(Node MB counts %zu bytes per node, before malloc overhead)\n",
+           sizeof(ChainedNode));
+}
+
+// Interleaved lookup benchmark settings
+#define INTERLEAVE_LOAD 2              // Keys per bucket, so chains have a next
+#define INTERLEAVE_BYTES_PER_KEY 36    // Node with malloc header + bucket share
+#define INTERLEAVE_LOOKUPS 2000000     // Lookups per measurement
+#define INTERLEAVE_REPS 3
+
+// Best of INTERLEAVE_REPS: ns per lookup of a get loop, get_batch and
+// get_interleaved over the same keys. Every method must agree on hits
+static void time_chained_methods(ChainedHashMap *map, const int *keys, int n,
+                                 int *values, bool *found, double *ns) {
+    volatile size_t sink = 0;
+    for (int m = 0; m < 3; m++) {
+        double best = 0;
+        for (int rep = 0; rep < INTERLEAVE_REPS; rep++) {
+            double t0 = get_time_ns();
+            size_t hits = 0;
+            if (m == 0) {
+                for (int i = 0; i < n; i++) {
+                    if (chained_get(map, keys[i], &values[i])) hits++;
+                }
+            } else if (m == 1) {
+                hits = chained_get_batch(map, keys, values, found, (size_t)n);
+            } else {
+                hits = chained_get_interleaved(map, keys, values, found,
+                                               (size_t)n);
+            }
+            double t = get_time_ns() - t0;
+            sink += hits;
+            if (rep == 0 || t < best) best = t;
+        }
+        ns[m] = best / n;
+    }
+}
+
+// Pointer-chasing lookups in a chained table of about table_mb megabytes:
+// one chain walk at a time (chained_get, chained_get_batch) vs
+// CHAINED_AMAC_LANES walks interleaved (chained_get_interleaved)
+void benchmark_interleaved(size_t table_mb) {
+    print_section_header("INTERLEAVED CHAIN LOOKUPS (AMAC)");
+    
+    size_t want = table_mb * 1024 * 1024 / INTERLEAVE_BYTES_PER_KEY;
+    int n = want > (size_t)INT32_MAX / 2 ? INT32_MAX / 2 : (int)want;
+    if (n < INTERLEAVE_LOAD) n = INTERLEAVE_LOAD;
+    int lookups = INTERLEAVE_LOOKUPS;
+    
+    int *keys = generate_distinct_keys(n, 0);
+    int *hits = malloc((size_t)lookups * sizeof(int));
+    int *misses = generate_distinct_keys(lookups, (unsigned int)n);
+    int *values = malloc((size_t)lookups * sizeof(int));
+    bool *found = malloc((size_t)lookups * sizeof(bool));
+    ChainedOptions opts = {0};
+    opts.seed = benchmark_seed();
+    ChainedHashMap *map = chained_create_with((size_t)n / INTERLEAVE_LOAD, &opts);
+    if (!keys || !hits || !misses || !values || !found || !map) {
+        printf("Out of memory\n");
+    } else {
+        for (int i = 0; i < n; i++) chained_put(map, keys[i], i);
+        // Random stored keys, so lookups do not follow allocation order
+        for (int i = 0; i < lookups; i++) {
+            hits[i] = keys[(int)(((unsigned)rand() * (RAND_MAX + 1u) +
+                                  (unsigned)rand()) % (unsigned)n)];
+        }
+        
+        double hit_ns[3], miss_ns[3];
+        time_chained_methods(map, hits, lookups, values, found, hit_ns);
+        time_chained_methods(map, misses, lookups, values, found, miss_ns);
+        
+        printf("%d keys, %zu buckets (~%zu MB), %d lookups, %d lanes, best of %d\n\n",
+               n, map->capacity, chained_memory_usage(map) / (1024 * 1024),
+               lookups, CHAINED_AMAC_LANES, INTERLEAVE_REPS);
+        printf("%-18s | %-8s | %-8s | %-7s\n", "Method", "Hit ns", "Miss ns",
+               "Speedup");
+        printf("-------------------|----------|----------|--------\n");
+        const char *names[] = {"chained_get", "chained_get_batch",
+                               "interleaved"};
+        for (int m = 0; m < 3; m++) {
+            printf("%-18s | %8.1f | %8.1f | %6.2fx\n", names[m], hit_ns[m],
+                   miss_ns[m], (hit_ns[0] + miss_ns[0]) / (hit_ns[m] + miss_ns[m]));
+        }
+    }
+    chained_destroy(map);
+    free(keys);
+    free(hits);
+    free(misses);
+    free(values);
+    free(found);
 }
 
 // Print benchmark results in formatted table
 static void print_benchmark_results(BenchmarkResult r) {
-    printf("Chained:        %.3f ms\n", r.chained_ms);
-    printf("Linear Probing: %.3f ms\n", r.linear_ms);
+    printf("Chained:        %.3f ms", r.chained_ms);
+    perf_print_sample(r.chained_perf);  // Per-op counters, if available
+    printf("\n");
+    printf("Linear Probing: %.3f ms", r.linear_ms);
+    perf_print_sample(r.linear_perf);
+    printf("\n");
     printf("Cuckoo:         %.3f ms", r.cuckoo_ms);
     if (r.cuckoo_rehashes > 0) {
         printf(" (rehashes: %d)", r.cuckoo_rehashes);
     }
+    perf_print_sample(r.cuckoo_perf);
+    printf("\n");
+    printf("Hopscotch:      %.3f ms", r.hopscotch_ms);
+    perf_print_sample(r.hopscotch_perf);
     printf("\n");
 }
 
@@ -268,6 +2019,9 @@ static void print_benchmark_results(BenchmarkResult r) {
 void run_all_benchmarks(int test_size, size_t capacity) {
     BenchmarkResult r;
     
+    // Open hardware counters once; falls back to time only
+    perf_init();
+    
     // Random keys benchmarks
     print_subsection("Random Keys");
     int *random_keys = generate_random_keys(test_size);
@@ -304,4 +2058,22 @@ void run_all_benchmarks(int test_size, size_t capacity) {
     benchmark_memory(test_size, capacity);
     benchmark_worst_case_lookup(test_size, capacity);
     benchmark_scaling();
+    benchmark_distributions();
+    benchmark_create_clear();
+    benchmark_cuckoo_stash();
+    benchmark_cuckoo_ways();
+    benchmark_adversarial();
+    benchmark_hash_simd();
+    benchmark_templates(test_size);
+    benchmark_frozen(test_size);
+    benchmark_cache();
+    benchmark_word_count(test_size);
+    benchmark_soa();
+    benchmark_unrolled();
+    benchmark_interleaved(64);
+    benchmark_probe_strategies();
+    benchmark_cuckoo_filter(test_size);
+    benchmark_wal(test_size);
+    
+    perf_shutdown();
 }
\ No newline at end of file
@@ -9,13 +9,19 @@
 #define TEST_BENCHMARKS_H // Prevent multiple inclusions
 
 #include <stddef.h>
+#include "test_perf.h"
 
 // Benchmark result structure
 typedef struct {
     double chained_ms;
     double linear_ms;
     double cuckoo_ms;
+    double hopscotch_ms;
     int cuckoo_rehashes;
+    PerfSample chained_perf;  // Hardware counters per operation
+    PerfSample linear_perf;
+    PerfSample cuckoo_perf;
+    PerfSample hopscotch_perf;
 } BenchmarkResult; // Structure to hold benchmark results
 
 // Run all benchmarks with specified parameters
@@ -30,5 +36,25 @@ BenchmarkResult benchmark_deletion(int *keys, int n, size_t capacity);
 void benchmark_memory(int n, size_t capacity);
 void benchmark_worst_case_lookup(int n, size_t capacity);
 void benchmark_scaling(void);
+void benchmark_distributions(void);
+void benchmark_hugepages(size_t slots);
+void benchmark_create_clear(void);
+void benchmark_cuckoo_stash(void);
+void benchmark_cuckoo_ways(void);
+void benchmark_adversarial(void);
+void benchmark_hash_simd(void);
+void benchmark_templates(int n);
+void benchmark_memory_sweep(size_t max_mb, const char *csv_path);
+void benchmark_threaded_lookups(int n, int max_threads);
+void benchmark_parallel_resize(int n, int max_threads);
+void benchmark_frozen(int n);
+void benchmark_cache(void);
+void benchmark_word_count(int n);
+void benchmark_soa(void);
+void benchmark_unrolled(void);
+void benchmark_interleaved(size_t table_mb);
+void benchmark_probe_strategies(void);
+void benchmark_cuckoo_filter(int n);
+void benchmark_wal(int n);
 
 #endif
\ No newline at end of file
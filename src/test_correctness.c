@@ -5,13 +5,24 @@
  * Class: CS 5008
  */
 
+#define _POSIX_C_SOURCE 200112L // setrlimit and SIGXFSZ for the log write failure test
+
 #include "test_correctness.h"
 #include "test_utils.h"
 #include "chained.h"
 #include "linear_probing.h"
 #include "cuckoo.h"
+#include "hopscotch.h"
+#include "linear_soa.h"
+#include "chained_unrolled.h"
+#include "cuckoo_filter.h"
+#include "wal.h"
+#include "hash_simd.h"
+#include "hashmap_template.h"
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/resource.h>
 
 // Helper macro for test assertions
 // Increments total tests and passed tests if condition is true
@@ -21,6 +32,27 @@
         if (condition) (result).passed++; \
     } while(0)
 
+// 64-bit keys for the template tests: fold the halves, then fmix32
+static inline uint32_t u64_hash(uint64_t key, uint32_t seed) {
+    return hashmap_int_hash((int)(uint32_t)(key ^ (key >> 32)), seed);
+}
+
+static inline bool u64_eq(uint64_t a, uint64_t b) {
+    return a == b;
+}
+
+// Every key collides, so each one probes past the keys put before it
+static inline uint32_t same_hash(int key, uint32_t seed) {
+    (void)key; (void)seed;
+    return 0;
+}
+
+// Template instantiations under test
+DEFINE_CHAINED_MAP(TplChained, int, int, hashmap_int_hash, hashmap_int_eq)
+DEFINE_LINEAR_MAP(TplLinear, int, int, hashmap_int_hash, hashmap_int_eq)
+DEFINE_LINEAR_MAP(TplCollide, int, int, same_hash, hashmap_int_eq)
+DEFINE_CUCKOO_MAP(TplCuckoo, uint64_t, double, u64_hash, u64_eq)
+
 // Test chained hash map basic operations
 TestResult test_chained_correctness(void) {
     TestResult result = {0, 0}; // Initialize test result
@@ -58,7 +90,133 @@ TestResult test_chained_correctness(void) {
     TEST_ASSERT(result, !chained_get(map, 25, &val));
     TEST_ASSERT(result, chained_size(map) == 49);
     
+#ifdef HASHMAP_STATS
+    // Test 8: Counters track hits and misses (stats builds only)
+    ChainedStats st;
+    TEST_ASSERT(result, chained_stats(map, &st) && st.hits == 3 &&
+                        st.misses == 3 && st.probes >= st.hits);
+#endif
+    
+    // Test 9: Clear empties the map and it can be reused
+    chained_clear(map);
+    TEST_ASSERT(result, chained_size(map) == 0 && !chained_get(map, 10, &val));
+    chained_put(map, 10, 1);
+    TEST_ASSERT(result, chained_get(map, 10, &val) && val == 1);
+    chained_destroy(map);
+    
+    // Test 10: Keys colliding under a leaked seed trigger a reseed
+    map = chained_create(1000);
+    int *flood = generate_colliding_keys(500, map->seed, 1000);
+    bool all_found = true;
+    for (int i = 0; i < 500; i++) {
+        chained_put(map, flood[i], i);
+    }
+    for (int i = 0; i < 500 && all_found; i++) {
+        all_found = chained_get(map, flood[i], &val) && val == i;
+    }
+    TEST_ASSERT(result, all_found && chained_reseed_count(map) > 0 &&
+                        chained_max_chain_length(map) < CHAINED_FLOOD_CHAIN);
+    chained_destroy(map);
+    free(flood);
+    
+    // Test 11: Every SIMD level hashes like the scalar path, and batch
+    // put/get agree with single-key get (misses included)
+    int keys[1000], values[1000], got[1000];
+    bool found[1000];
+    unsigned int h_scalar[1000], h_simd[1000];
+    for (int i = 0; i < 1000; i++) {
+        keys[i] = i * 7919 - 500000;
+        values[i] = i;
+    }
+    bool same = true;
+    hash_batch_with(HASH_SIMD_SCALAR, keys, 0x9e3779b9, h_scalar, 1000);
+    for (int level = HASH_SIMD_AVX2; level <= HASH_SIMD_AVX512; level++) {
+        hash_batch_with((HashSimdLevel)level, keys, 0x9e3779b9, h_simd, 999);
+        for (int i = 0; i < 999; i++) same = same && h_simd[i] == h_scalar[i];
+    }
+    map = chained_create(500);
+    chained_put_batch(map, keys, values, 900);  // Last 100 stay absent
+    size_t hits = chained_get_batch(map, keys, got, found, 1000);
+    for (int i = 0; i < 1000 && same; i++) {
+        same = found[i] == (i < 900) && (!found[i] || got[i] == i) &&
+               found[i] == chained_get(map, keys[i], &val);
+    }
+    TEST_ASSERT(result, same && hits == 900 && chained_size(map) == 900);
+    
+    // Test 12: Frozen copy finds every key and rejects the absent ones
+    FrozenMap *frozen = chained_freeze(map);
+    same = frozen && frozen_size(frozen) == 900;
+    for (int i = 0; i < 1000 && same; i++) {
+        same = frozen_get(frozen, keys[i], &val) == (i < 900) &&
+               (i >= 900 || val == i);
+    }
+    TEST_ASSERT(result, same);
+    frozen_destroy(frozen);
+    chained_destroy(map);
+    
+    // Test 13: find_or_insert reports a new key once, add counts repeats
+    map = chained_create(16);
+    bool inserted;
+    int *slot = chained_find_or_insert(map, 5, &inserted);
+    same = slot && inserted && *slot == 0;
+    if (slot) *slot = 7;
+    slot = chained_find_or_insert(map, 5, &inserted);
+    same = same && slot && !inserted && *slot == 7;
+    for (int i = 0; i < 300; i++) chained_add(map, i % 30, 1);
+    TEST_ASSERT(result, same && chained_size(map) == 30 &&
+                        chained_get(map, 5, &val) && val == 17 &&
+                        chained_get(map, 29, &val) && val == 10);
+    chained_destroy(map);
+    
+    // Test 14: Interleaved lookups over long chains find every stored key
+    // and report the misses, with and without output arrays
+    map = chained_create(16);
+    for (int i = 0; i < 500; i++) chained_put(map, keys[i], i);
+    for (int i = 0; i < 1000; i++) got[i] = -1;
+    hits = chained_get_interleaved(map, keys, got, found, 1000);
+    same = chained_get_interleaved(map, keys, NULL, NULL, 7) == 7;
+    for (int i = 0; i < 1000 && same; i++) {
+        same = found[i] == (i < 500) && got[i] == (i < 500 ? i : -1);
+    }
+    TEST_ASSERT(result, same && hits == 500);
+    chained_destroy(map);
+    
+    // Test 15: Resizing on four threads relinks every node, chains shorten
+    ChainedOptions resize_opts = {0};
+    resize_opts.resize_threads = 4;
+    map = chained_create_with(1024, &resize_opts);
+    for (int i = 0; i < 100000; i++) chained_put(map, i * 7, i);
+    same = chained_resize(map, 1 << 17) && map->capacity == 1 << 17 &&
+           chained_size(map) == 100000;
+    for (int i = 0; i < 100000 && same; i++) {
+        same = chained_get(map, i * 7, &val) && val == i;
+    }
+#ifdef HASHMAP_STATS
+    // Flood reseeds are rebuilds too
+    same = same && chained_stats(map, &st) &&
+           st.resizes == 1 + (size_t)chained_reseed_count(map);
+#endif
+    TEST_ASSERT(result, same && chained_max_chain_length(map) < 20);
+    chained_destroy(map);
+    
+#ifdef HASHMAP_TTL
+    // Test 16: Expired keys miss and are freed on access, the bounded
+    // sweep frees the rest (TTL builds only)
+    map = chained_create(64);
+    for (int i = 0; i < 100; i++) {
+        chained_put_ttl(map, i, i, i % 2 ? 0 : 10);  // Even keys expire at 10
+    }
+    chained_set_time(map, 9);
+    same = chained_get(map, 0, &val);
+    chained_set_time(map, 10);
+    same = same && !chained_get(map, 0, &val) && chained_size(map) == 99;
+    size_t swept = 0;
+    for (int step = 0; step < 8; step++) swept += chained_expire_step(map, 8);
+    TEST_ASSERT(result, same && swept == 49 && chained_size(map) == 50 &&
+                        chained_get(map, 1, &val) && val == 1);
     chained_destroy(map);
+#endif
+    
     printf("  Chained: %d/%d tests passed\n", result.passed, result.total);
     return result;
 }
@@ -100,7 +258,188 @@ TestResult test_linear_correctness(void) {
     int probes = linear_probe_count(map, 42);
     TEST_ASSERT(result, probes > 0 && probes <= 50);
     
+#ifdef HASHMAP_STATS
+    // Test 8: Counters track lookups and tombstones (stats builds only)
+    LinearStats st;
+    linear_delete(map, 0);
+    TEST_ASSERT(result, linear_stats(map, &st) && st.hits == 3 &&
+                        st.misses == 2 && st.tombstones == 1);
+#endif
+    
+    // Test 9: Clear empties the map, tombstones included
+    linear_clear(map);
+    TEST_ASSERT(result, linear_size(map) == 0 && !linear_get(map, 42, &val) &&
+                        linear_probe_count(map, 0) == 1);
+    linear_destroy(map);
+    
+    // Test 10: Huge page backed table behaves like the calloc one
+    LinearOptions opts = {0};
+    opts.alloc.mode = TABLE_ALLOC_HUGEPAGE;
+    map = linear_create_with(100, &opts);
+    linear_put(map, 7, 70);
+    TEST_ASSERT(result, map && linear_get(map, 7, &val) && val == 70 &&
+                        !linear_get(map, 8, &val));
+    linear_destroy(map);
+    
+    // Test 11: Keys colliding under a leaked seed trigger a reseed
+    map = linear_create(2000);
+    int *flood = generate_colliding_keys(500, map->seed, 2000);
+    bool all_found = true;
+    for (int i = 0; i < 500; i++) {
+        linear_put(map, flood[i], i);
+    }
+    for (int i = 0; i < 500 && all_found; i++) {
+        all_found = linear_get(map, flood[i], &val) && val == i &&
+                    linear_probe_count(map, flood[i]) < LINEAR_FLOOD_PROBES;
+    }
+    TEST_ASSERT(result, all_found && linear_size(map) == 500 &&
+                        linear_reseed_count(map) > 0);
+    linear_destroy(map);
+    free(flood);
+    
+    // Test 12: Batch put/get agree with single-key get (misses included)
+    int keys[1000], values[1000], got[1000];
+    bool found[1000];
+    for (int i = 0; i < 1000; i++) {
+        keys[i] = i * 7919 - 500000;
+        values[i] = i;
+    }
+    map = linear_create(2000);
+    linear_put_batch(map, keys, values, 900);  // Last 100 stay absent
+    size_t hits = linear_get_batch(map, keys, got, found, 1000);
+    all_found = true;
+    for (int i = 0; i < 1000 && all_found; i++) {
+        all_found = found[i] == (i < 900) && (!found[i] || got[i] == i) &&
+                    found[i] == linear_get(map, keys[i], &val);
+    }
+    TEST_ASSERT(result, all_found && hits == 900 && linear_size(map) == 900);
+    
+    // Test 13: Frozen copy skips deleted slots and has one entry per key
+    for (int i = 0; i < 100; i++) linear_delete(map, keys[i]);
+    FrozenMap *frozen = linear_freeze(map);
+    all_found = frozen && frozen_size(frozen) == 800 &&
+                frozen_memory_usage(frozen) <= 800 * (sizeof(FrozenEntry) + 2);
+    for (int i = 0; i < 1000 && all_found; i++) {
+        all_found = frozen_get(frozen, keys[i], &val) == (i >= 100 && i < 900) &&
+                    (i < 100 || i >= 900 || val == i);
+    }
+    TEST_ASSERT(result, all_found);
+    frozen_destroy(frozen);
+    linear_destroy(map);
+    
+    // Test 14: CLOCK cache mode holds 75% of the slots, keeps a key that
+    // is read between inserts, and every resident key stays reachable;
+    // even a one-slot cache evicts rather than refusing a new key
+    LinearOptions clock_opts = {0};
+    clock_opts.cache = CACHE_CLOCK;
+    map = linear_create_with(100, &clock_opts);
+    linear_put(map, -1, 42);
+    for (int i = 0; i < 1000; i++) {
+        linear_put(map, i, i);
+        linear_get(map, -1, &val);
+    }
+    int resident = 0;
+    all_found = linear_get(map, -1, &val) && val == 42;
+    for (int i = 0; i < 1000; i++) {
+        if (linear_get(map, i, &val)) {
+            resident++;
+            all_found = all_found && val == i;
+        }
+    }
+    all_found = all_found && linear_size(map) == 75 && resident == 74 &&
+                linear_evictions(map) == 926;
+    linear_destroy(map);
+    // A one-slot cache evicts its only key for a new one
+    map = linear_create_with(1, &clock_opts);
+    linear_put(map, 1, 10);
+    bool replaced = linear_put(map, 2, 20) && linear_get(map, 2, &val) &&
+                    val == 20 && !linear_get(map, 1, &val) &&
+                    linear_evictions(map) == 1;
+    TEST_ASSERT(result, all_found && replaced && linear_size(map) == 1);
+    linear_destroy(map);
+    
+    // Test 15: add past tombstones updates the live key instead of
+    // inserting a duplicate, and reuses tombstones for new keys
+    map = linear_create(64);
+    for (int i = 0; i < 50; i++) linear_put(map, i, i);
+    for (int i = 0; i < 10; i++) linear_delete(map, i);
+    bool inserted;
+    all_found = linear_find_or_insert(map, 20, &inserted) && !inserted;
+    for (int i = 0; i < 50; i++) linear_add(map, i, 1);
+    for (int i = 0; i < 50; i++) {
+        all_found = all_found && linear_get(map, i, &val) &&
+                    val == (i < 10 ? 1 : i + 1);
+    }
+    TEST_ASSERT(result, all_found && linear_size(map) == 50);
+    linear_destroy(map);
+    
+    // Test 16: Quadratic and double hashing round the capacity up to a
+    // power of two and reach every slot: a full table finds all its keys
+    ProbeStrategy strategies[] = {PROBE_QUADRATIC, PROBE_DOUBLE};
+    for (int s = 0; s < 2; s++) {
+        LinearOptions probe_opts = {0};
+        probe_opts.probe = strategies[s];
+        map = linear_create_with(100, &probe_opts);
+        all_found = map && map->capacity == 128;
+        for (int i = 0; i < 128 && all_found; i++) {
+            all_found = linear_put(map, i, -i);
+        }
+        all_found = all_found && !linear_put(map, 128, 0);  // Full
+        for (int i = 0; i < 128 && all_found; i++) {
+            all_found = linear_get(map, i, &val) && val == -i &&
+                        linear_probe_count(map, i) <= 128;
+        }
+        for (int i = 0; i < 128 && all_found; i += 2) linear_delete(map, i);
+        for (int i = 1000; i < 1064 && all_found; i++) {
+            all_found = linear_put(map, i, i);
+        }
+        size_t hist[129];
+        size_t counted = 0;
+        linear_probe_histogram(map, hist, NULL, 129);
+        for (int k = 0; k < 129; k++) counted += hist[k];
+        TEST_ASSERT(result, all_found && linear_size(map) == 128 &&
+                            counted == 128 && !linear_get(map, 2, &val) &&
+                            linear_get(map, 1063, &val) && val == 1063);
+        linear_destroy(map);
+    }
+    
+    // Test 17: Resizing on four threads keeps every key and drops tombstones
+    LinearOptions resize_opts = {0};
+    resize_opts.resize_threads = 4;
+    map = linear_create_with(1 << 17, &resize_opts);
+    for (int i = 0; i < 100000; i++) linear_put(map, i * 7, i);
+    for (int i = 0; i < 100000; i += 10) linear_delete(map, i * 7);
+    all_found = linear_resize(map, 1 << 18) && map->capacity == 1 << 18 &&
+                linear_size(map) == 90000 && !linear_resize(map, 1000);
+    for (int i = 0; i < 100000 && all_found; i++) {
+        all_found = linear_get(map, i * 7, &val) == (i % 10 != 0) &&
+                    (i % 10 == 0 || val == i);
+    }
+#ifdef HASHMAP_STATS
+    // The refused resize is not counted; flood reseeds are
+    all_found = all_found && linear_stats(map, &st) &&
+                st.resizes == 1 + (size_t)linear_reseed_count(map);
+#endif
+    TEST_ASSERT(result, all_found);
+    linear_destroy(map);
+    
+#ifdef HASHMAP_TTL
+    // Test 18: Expired keys miss and are tombstoned on access, the bounded
+    // sweep removes the rest and later keys stay reachable (TTL builds only)
+    map = linear_create(256);
+    for (int i = 0; i < 100; i++) {
+        linear_put_ttl(map, i, i, i % 2 ? 0 : 10);  // Even keys expire at 10
+    }
+    linear_set_time(map, 10);
+    all_found = !linear_get(map, 0, &val) && linear_size(map) == 99;
+    size_t swept = 0;
+    for (int step = 0; step < 4; step++) swept += linear_expire_step(map, 64);
+    for (int i = 1; i < 100; i += 2) {
+        all_found = all_found && linear_get(map, i, &val) && val == i;
+    }
+    TEST_ASSERT(result, all_found && swept == 49 && linear_size(map) == 50);
     linear_destroy(map);
+#endif
     printf("  Linear Probing: %d/%d tests passed\n", result.passed, result.total);
     return result;
 }
@@ -147,11 +486,675 @@ TestResult test_cuckoo_correctness(void) {
     // Test 7: Load factor is reasonable
     TEST_ASSERT(result, cuckoo_load_factor(map) > 0 && cuckoo_load_factor(map) < 1);
     
+#ifdef HASHMAP_STATS
+    // Test 8: Counters track lookups and resizes (stats builds only)
+    CuckooStats st;
+    TEST_ASSERT(result, cuckoo_stats(map, &st) && st.hits == 52 &&
+                        st.misses == 2 && st.resizes == 0);
+#endif
+    
+    // Test 9: Clear empties the map and it can be reused
+    cuckoo_clear(map);
+    TEST_ASSERT(result, cuckoo_size(map) == 0 && !cuckoo_get(map, 7, &val));
+    cuckoo_destroy(map);
+    
+    // Test 10: mmap backed tables survive resizing and clearing
+    CuckooOptions opts = {0};
+    opts.alloc.mode = TABLE_ALLOC_MMAP;
+    map = cuckoo_create_with(8, &opts);
+    for (int i = 0; i < 1000; i++) {
+        cuckoo_put(map, i, i + 1);
+    }
+    all_found = cuckoo_size(map) == 1000;
+    for (int i = 0; i < 1000 && all_found; i++) {
+        all_found = cuckoo_get(map, i, &val) && val == i + 1;
+    }
+    cuckoo_clear(map);
+    TEST_ASSERT(result, all_found && cuckoo_size(map) == 0 &&
+                        !cuckoo_get(map, 5, &val));
+    cuckoo_destroy(map);
+    
+    // Test 11: Same caller seed gives the same table layout
+    CuckooOptions seeded = {0};
+    seeded.seed = 12345;
+    CuckooHashMap *a = cuckoo_create_with(64, &seeded);
+    CuckooHashMap *b = cuckoo_create_with(64, &seeded);
+    for (int i = 0; i < 200; i++) {
+        cuckoo_put(a, i * 7, i);
+        cuckoo_put(b, i * 7, i);
+    }
+    size_t hist_a[2], hist_b[2];
+    cuckoo_table_histogram(a, hist_a, 2);
+    cuckoo_table_histogram(b, hist_b, 2);
+    TEST_ASSERT(result, a->seeds[0] == b->seeds[0] && a->seeds[1] == b->seeds[1] &&
+                        hist_a[0] == hist_b[0] && hist_a[1] == hist_b[1]);
+    cuckoo_destroy(a);
+    cuckoo_destroy(b);
+    
+    // Test 12: Stash absorbs failed chains, keys stay reachable and deletable
+    CuckooOptions tight = {0};
+    tight.max_load = 0.499;  // Do not grow, force chains to fail
+    map = cuckoo_create_with(16, &tight);
+    for (int i = 0; i < 16; i++) {
+        cuckoo_put(map, i * 31, i);
+    }
+    all_found = cuckoo_size(map) == 16;
+    for (int i = 0; i < 16 && all_found; i++) {
+        all_found = cuckoo_get(map, i * 31, &val) && val == i;
+    }
+    for (int i = 0; i < 16 && all_found; i++) {
+        all_found = cuckoo_delete(map, i * 31) && !cuckoo_get(map, i * 31, &val);
+    }
+    TEST_ASSERT(result, all_found && cuckoo_size(map) == 0 && map->stash_count == 0);
+    cuckoo_destroy(map);
+    
+    // Test 13: mmap backed tables behave like the calloc ones
+    map = cuckoo_create_with(1000, &opts);
+    for (int i = 0; i < 500; i++) {
+        cuckoo_put(map, i, i + 1);
+    }
+    all_found = cuckoo_size(map) == 500;
+    for (int i = 0; i < 500 && all_found; i++) {
+        all_found = cuckoo_get(map, i, &val) && val == i + 1;
+    }
+    TEST_ASSERT(result, all_found);
+    cuckoo_destroy(map);
+    
+    // Test 14: 3 and 4 way maps hold 85% / 90% load without growing
+    for (int ways = 3; ways <= 4; ways++) {
+        CuckooOptions dary = {0};
+        dary.ways = ways;
+        dary.max_load = 0.95;
+        map = cuckoo_create_with(1000, &dary);
+        int n = ways == 3 ? 2550 : 3600;
+        for (int i = 0; i < n; i++) {
+            cuckoo_put(map, i * 13, i);
+        }
+        all_found = cuckoo_size(map) == (size_t)n && map->capacity == 1000;
+        for (int i = 0; i < n && all_found; i++) {
+            all_found = cuckoo_get(map, i * 13, &val) && val == i;
+        }
+        TEST_ASSERT(result, all_found && cuckoo_delete(map, 13) &&
+                            !cuckoo_get(map, 13, &val));
+        cuckoo_destroy(map);
+    }
+    
+    // Test 15: Batch put through several resizes, batch get agrees
+    // with single-key get (misses included)
+    int keys[1000], values[1000], got[1000];
+    bool found[1000];
+    for (int i = 0; i < 1000; i++) {
+        keys[i] = i * 7919 - 500000;
+        values[i] = i;
+    }
+    CuckooOptions three = {0};
+    three.ways = 3;
+    map = cuckoo_create_with(8, &three);
+    size_t stored = cuckoo_put_batch(map, keys, values, 900);
+    size_t hits = cuckoo_get_batch(map, keys, got, found, 1000);
+    all_found = map->capacity > 8;
+    for (int i = 0; i < 1000 && all_found; i++) {
+        all_found = found[i] == (i < 900) && (!found[i] || got[i] == i) &&
+                    found[i] == cuckoo_get(map, keys[i], &val);
+    }
+    TEST_ASSERT(result, all_found && stored == 900 && hits == 900);
+    
+    // Test 16: Frozen copy finds every key; an empty map freezes too
+    FrozenMap *frozen = cuckoo_freeze(map);
+    all_found = frozen && frozen_size(frozen) == 900;
+    for (int i = 0; i < 1000 && all_found; i++) {
+        all_found = frozen_get(frozen, keys[i], &val) == (i < 900) &&
+                    (i >= 900 || val == i);
+    }
+    frozen_destroy(frozen);
+    cuckoo_clear(map);
+    frozen = cuckoo_freeze(map);
+    TEST_ASSERT(result, all_found && frozen && !frozen_get(frozen, keys[0], &val));
+    frozen_destroy(frozen);
+    cuckoo_destroy(map);
+    
+    // Test 17: Sampled LRU cache mode never grows, accounts for every key
+    // and keeps a key that is read between inserts
+    CuckooOptions lru = {0};
+    lru.cache = CACHE_SAMPLED_LRU;
+    map = cuckoo_create_with(64, &lru);
+    cuckoo_put(map, -1, 42);
+    for (int i = 0; i < 1000; i++) {
+        cuckoo_put(map, i, i);
+        cuckoo_get(map, -1, &val);
+    }
+    TEST_ASSERT(result, map->capacity == 64 && cuckoo_rehash_count(map) == 0 &&
+                        cuckoo_size(map) + cuckoo_evictions(map) == 1001 &&
+                        cuckoo_get(map, -1, &val) && val == 42);
+    cuckoo_destroy(map);
+    
+    // Test 18: add keeps counting through growth and kick chains
+    map = cuckoo_create(16);
+    for (int r = 0; r < 3; r++) {
+        for (int i = 0; i < 1000; i++) cuckoo_add(map, i, 1);
+    }
+    all_found = cuckoo_size(map) == 1000;
+    for (int i = 0; i < 1000; i++) {
+        all_found = all_found && cuckoo_get(map, i, &val) && val == 3;
+    }
+    TEST_ASSERT(result, all_found && map->capacity > 16);
+    cuckoo_destroy(map);
+    
+    // Test 19: Growth and an explicit resize on four threads keep every key
+    CuckooOptions resize_opts = {0};
+    resize_opts.resize_threads = 4;
+    map = cuckoo_create_with(16, &resize_opts);
+    for (int i = 0; i < 100000; i++) cuckoo_put(map, i * 7, i);
+    size_t grown = map->capacity;
+    all_found = cuckoo_resize(map, grown * 2) && map->capacity == grown * 2 &&
+                cuckoo_size(map) == 100000 && !cuckoo_resize(map, 100);
+    for (int i = 0; i < 100000 && all_found; i++) {
+        all_found = cuckoo_get(map, i * 7, &val) && val == i;
+    }
+    TEST_ASSERT(result, all_found);
     cuckoo_destroy(map);
+    
+#ifdef HASHMAP_TTL
+    // Test 20: Deadlines survive kick chains and growth, expired keys miss,
+    // the bounded sweep clears the rest (TTL builds only)
+    map = cuckoo_create(16);
+    for (int i = 0; i < 100; i++) {
+        cuckoo_put_ttl(map, i, i, i % 2 ? 0 : 10);  // Even keys expire at 10
+    }
+    cuckoo_set_time(map, 9);
+    all_found = cuckoo_get(map, 0, &val) && map->capacity > 16;
+    cuckoo_set_time(map, 10);
+    all_found = all_found && !cuckoo_get(map, 0, &val) && cuckoo_size(map) == 99;
+    size_t swept = 0;
+    for (size_t done = 0; done < 2 * map->capacity; done += 16) {
+        swept += cuckoo_expire_step(map, 16);
+    }
+    for (int i = 1; i < 100; i += 2) {
+        all_found = all_found && cuckoo_get(map, i, &val) && val == i;
+    }
+    TEST_ASSERT(result, all_found && swept == 49 && cuckoo_size(map) == 50);
+    cuckoo_destroy(map);
+#endif
     printf("  Cuckoo: %d/%d tests passed\n", result.passed, result.total);
     return result;
 }
 
+// Test hopscotch hash map basic operations
+TestResult test_hopscotch_correctness(void) {
+    TestResult result = {0, 0};
+    int val;
+    
+    printf("Testing Hopscotch HashMap...\n");
+    HopscotchHashMap *map = hopscotch_create(100);
+    
+    // Test 1: Insert and retrieve
+    hopscotch_put(map, 42, 100);
+    TEST_ASSERT(result, hopscotch_get(map, 42, &val) && val == 100);
+    
+    // Test 2: Update existing key
+    hopscotch_put(map, 42, 200);
+    TEST_ASSERT(result, hopscotch_get(map, 42, &val) && val == 200 &&
+                        hopscotch_size(map) == 1);
+    
+    // Test 3: Delete key
+    hopscotch_delete(map, 42);
+    TEST_ASSERT(result, !hopscotch_get(map, 42, &val));
+    
+    // Test 4: Miss on non-existent key
+    TEST_ASSERT(result, !hopscotch_get(map, 999, &val));
+    
+    // Test 5: Multiple inserts
+    for (int i = 0; i < 50; i++) {
+        hopscotch_put(map, i, i * 10);
+    }
+    TEST_ASSERT(result, hopscotch_size(map) == 50);
+    
+    // Test 6: Delete from middle
+    hopscotch_delete(map, 25);
+    TEST_ASSERT(result, !hopscotch_get(map, 25, &val) &&
+                        hopscotch_get(map, 26, &val) && val == 260 &&
+                        hopscotch_size(map) == 49);
+    hopscotch_destroy(map);
+    
+    // Test 7: Filling past capacity grows the table, every key stays
+    // within HOPSCOTCH_NEIGHBORHOOD slots of home
+    map = hopscotch_create(HOPSCOTCH_NEIGHBORHOOD);
+    for (int i = 0; i < 1000; i++) {
+        hopscotch_put(map, i * 64, i);  // Keys sharing low bits
+    }
+    bool all_found = hopscotch_size(map) == 1000 &&
+                     hopscotch_resize_count(map) > 0;
+    for (int i = 0; i < 1000 && all_found; i++) {
+        all_found = hopscotch_get(map, i * 64, &val) && val == i &&
+                    hopscotch_probe_count(map, i * 64) <= HOPSCOTCH_NEIGHBORHOOD;
+    }
+    TEST_ASSERT(result, all_found);
+    hopscotch_destroy(map);
+    
+    printf("  Hopscotch: %d/%d tests passed\n", result.passed, result.total);
+    return result;
+}
+
+// Test structure-of-arrays linear probing hash map basic operations
+TestResult test_linear_soa_correctness(void) {
+    TestResult result = {0, 0};
+    int val;
+    
+    printf("Testing SoA Linear Probing HashMap...\n");
+    LinearSoaMap *map = linear_soa_create(100);  // Rounded up to 128
+    
+    // Test 1: Insert, update and retrieve
+    linear_soa_put(map, 42, 100);
+    linear_soa_put(map, 42, 200);
+    TEST_ASSERT(result, linear_soa_get(map, 42, &val) && val == 200 &&
+                        linear_soa_size(map) == 1 && map->capacity == 128);
+    
+    // Test 2: Delete key, miss on non-existent key
+    linear_soa_delete(map, 42);
+    TEST_ASSERT(result, !linear_soa_get(map, 42, &val) &&
+                        !linear_soa_get(map, 999, &val));
+    
+    // Test 3: Fill to all but one slot; clusters span occupancy words and
+    // wrap around the end, and the last slot is refused
+    bool all_found = true;
+    for (int i = 0; i < 127; i++) all_found = all_found && linear_soa_put(map, i, i);
+    all_found = all_found && !linear_soa_put(map, 1000, 0);
+    for (int i = 0; i < 127 && all_found; i++) {
+        all_found = linear_soa_get(map, i, &val) && val == i;
+    }
+    TEST_ASSERT(result, all_found && !linear_soa_get(map, 1000, &val));
+    
+    // Test 4: Backward shift deletion keeps every other key reachable
+    for (int i = 0; i < 127; i += 2) linear_soa_delete(map, i);
+    for (int i = 0; i < 127 && all_found; i++) {
+        all_found = linear_soa_get(map, i, &val) == (i % 2 == 1);
+    }
+    TEST_ASSERT(result, all_found && linear_soa_size(map) == 63);
+    
+    // Test 5: Clear empties the map and it can be reused
+    linear_soa_clear(map);
+    linear_soa_put(map, 7, 70);
+    TEST_ASSERT(result, linear_soa_size(map) == 1 && !linear_soa_get(map, 1, &val) &&
+                        linear_soa_get(map, 7, &val) && val == 70);
+    linear_soa_destroy(map);
+    
+    printf("  SoA Linear: %d/%d tests passed\n", result.passed, result.total);
+    return result;
+}
+
+// Test unrolled chained hash map basic operations
+TestResult test_chained_unrolled_correctness(void) {
+    TestResult result = {0, 0};
+    int val;
+    
+    printf("Testing Unrolled Chained HashMap...\n");
+    ChainedUnrolledMap *map = chained_unrolled_create(100);
+    
+    // Test 1: Insert, update and retrieve
+    chained_unrolled_put(map, 42, 100);
+    chained_unrolled_put(map, 42, 200);
+    TEST_ASSERT(result, chained_unrolled_get(map, 42, &val) && val == 200 &&
+                        chained_unrolled_size(map) == 1);
+    
+    // Test 2: Delete key frees its block, miss on non-existent key
+    chained_unrolled_delete(map, 42);
+    TEST_ASSERT(result, !chained_unrolled_get(map, 42, &val) &&
+                        !chained_unrolled_get(map, 999, &val) &&
+                        chained_unrolled_block_count(map) == 0);
+    chained_unrolled_destroy(map);
+    
+    // Test 3: One bucket, 20 keys: three blocks, every key reachable
+    map = chained_unrolled_create(1);
+    for (int i = 0; i < 20; i++) chained_unrolled_put(map, i, i * 10);
+    bool all_found = chained_unrolled_block_count(map) == 3;
+    for (int i = 0; i < 20 && all_found; i++) {
+        all_found = chained_unrolled_get(map, i, &val) && val == i * 10;
+    }
+    TEST_ASSERT(result, all_found && chained_unrolled_max_chain_length(map) == 20);
+    
+    // Test 4: Deletes from full blocks refill from the head block, which
+    // is freed once empty
+    for (int i = 0; i < 20; i += 2) chained_unrolled_delete(map, i);
+    for (int i = 0; i < 20 && all_found; i++) {
+        all_found = chained_unrolled_get(map, i, &val) == (i % 2 == 1) &&
+                    (i % 2 == 0 || val == i * 10);
+    }
+    TEST_ASSERT(result, all_found && chained_unrolled_size(map) == 10 &&
+                        chained_unrolled_block_count(map) == 2);
+    
+    // Test 5: Clear empties the map and it can be reused
+    chained_unrolled_clear(map);
+    chained_unrolled_put(map, 7, 70);
+    TEST_ASSERT(result, chained_unrolled_size(map) == 1 &&
+                        chained_unrolled_block_count(map) == 1 &&
+                        !chained_unrolled_get(map, 1, &val) &&
+                        chained_unrolled_get(map, 7, &val) && val == 70);
+    chained_unrolled_destroy(map);
+    
+    printf("  Unrolled Chained: %d/%d tests passed\n", result.passed, result.total);
+    return result;
+}
+
+// Test the cuckoo filter (approximate membership)
+TestResult test_cuckoo_filter_correctness(void) {
+    TestResult result = {0, 0};
+    bool all_found = true;
+    
+    printf("Testing Cuckoo Filter...\n");
+    
+    // Test 1: Every inserted key is reported present (no false negatives)
+    CuckooFilterOptions opts = {0};
+    opts.seed = 99;
+    CuckooFilter *filter = cuckoo_filter_create_with(10000, &opts);
+    for (int i = 0; i < 10000; i++) {
+        all_found = all_found && cuckoo_filter_insert(filter, i * 3);
+    }
+    for (int i = 0; i < 10000 && all_found; i++) {
+        all_found = cuckoo_filter_contains(filter, i * 3);
+    }
+    TEST_ASSERT(result, all_found && cuckoo_filter_size(filter) == 10000 &&
+                        filter->fingerprint_bits == CUCKOO_FILTER_DEFAULT_BITS);
+    
+    // Test 2: Absent keys are rarely reported, near the predicted rate
+    int false_positives = 0;
+    for (int i = 0; i < 100000; i++) {
+        if (cuckoo_filter_contains(filter, -1 - i)) false_positives++;
+    }
+    double expected = cuckoo_filter_expected_fpr(filter);
+    TEST_ASSERT(result, expected > 0 && expected < 0.01 &&
+                        false_positives < 100000 * expected * 2 + 10);
+    
+    // Test 3: Deleting every key empties the filter; other keys stay
+    for (int i = 0; i < 10000; i += 2) cuckoo_filter_delete(filter, i * 3);
+    for (int i = 1; i < 10000 && all_found; i += 2) {
+        all_found = cuckoo_filter_contains(filter, i * 3);
+    }
+    for (int i = 1; i < 10000; i += 2) cuckoo_filter_delete(filter, i * 3);
+    TEST_ASSERT(result, all_found && cuckoo_filter_size(filter) == 0 &&
+                        !cuckoo_filter_contains(filter, 3) &&
+                        !cuckoo_filter_delete(filter, 3));
+    cuckoo_filter_destroy(filter);
+    
+    // Test 4: Fingerprint bits set the table size; bad sizes are refused
+    opts.fingerprint_bits = 8;
+    filter = cuckoo_filter_create_with(1000, &opts);
+    for (int i = 0; i < 1000; i++) cuckoo_filter_insert(filter, i);
+    opts.fingerprint_bits = 17;
+    TEST_ASSERT(result, filter && filter->buckets == 512 &&
+                        cuckoo_filter_bits_per_key(filter) == 8 * 2048 / 1000.0 &&
+                        !cuckoo_filter_create_with(1000, &opts));
+    cuckoo_filter_destroy(filter);
+    
+    // Test 5: A full filter refuses inserts but keeps every stored key,
+    // and a delete makes room again
+    opts.fingerprint_bits = 16;
+    filter = cuckoo_filter_create_with(64, &opts);
+    int stored = 0;
+    while (stored < 1000 && cuckoo_filter_insert(filter, stored)) stored++;
+    all_found = stored < 1000 && !cuckoo_filter_insert(filter, 5000);
+    for (int i = 0; i < stored && all_found; i++) {
+        all_found = cuckoo_filter_contains(filter, i);
+    }
+    cuckoo_filter_delete(filter, 0);
+    cuckoo_filter_delete(filter, 1);
+    TEST_ASSERT(result, all_found && cuckoo_filter_insert(filter, 5000) &&
+                        cuckoo_filter_contains(filter, 5000));
+    
+    // Test 6: Clear empties the filter and it can be reused
+    cuckoo_filter_clear(filter);
+    TEST_ASSERT(result, cuckoo_filter_size(filter) == 0 &&
+                        !cuckoo_filter_contains(filter, 2) &&
+                        cuckoo_filter_insert(filter, 2) &&
+                        cuckoo_filter_contains(filter, 2));
+    cuckoo_filter_destroy(filter);
+    
+    printf("  Cuckoo Filter: %d/%d tests passed\n", result.passed, result.total);
+    return result;
+}
+
+// Test the write-ahead log (logging, replay, group commit)
+TestResult test_wal_correctness(void) {
+    TestResult result = {0, 0};
+    const char *path = "test_wal.log";
+    bool all_found = true;
+    int val;
+    
+    printf("Testing Write-Ahead Log...\n");
+    remove(path);
+    
+    // Test 1: Puts, updates and deletes survive a reopen into a fresh map
+    ChainedHashMap *ch = chained_create(16);
+    Wal *wal = wal_open(path, ch, &wal_chained_ops, NULL);
+    for (int i = 0; i < 10000; i++) wal_put(wal, i, i * 2);
+    for (int i = 0; i < 10000; i += 2) wal_delete(wal, i);
+    wal_put(wal, 1, -1);
+    bool absent_refused = !wal_delete(wal, 0);
+    wal_close(wal);
+    chained_destroy(ch);
+    ch = chained_create(16);
+    wal = wal_open(path, ch, &wal_chained_ops, NULL);
+    for (int i = 3; i < 10000 && all_found; i += 2) {
+        all_found = chained_get(ch, i, &val) && val == i * 2;
+    }
+    TEST_ASSERT(result, wal && absent_refused && all_found &&
+                        wal_replay_count(wal) == 15001 &&
+                        chained_size(ch) == 5000 &&
+                        chained_get(ch, 1, &val) && val == -1 &&
+                        !chained_get(ch, 0, &val));
+    wal_close(wal);
+    chained_destroy(ch);
+    
+    // Test 2: The same log replays into the other map types
+    // (linear probing does not grow, so it is sized for the keys)
+    LinearHashMap *lin = linear_create(10000);
+    CuckooHashMap *ck = cuckoo_create(16);
+    Wal *wal_lin = wal_open(path, lin, &wal_linear_ops, NULL);
+    Wal *wal_ck = wal_open(path, ck, &wal_cuckoo_ops, NULL);
+    TEST_ASSERT(result, wal_lin && wal_ck &&
+                        linear_size(lin) == 5000 && cuckoo_size(ck) == 5000 &&
+                        linear_get(lin, 9999, &val) && val == 19998 &&
+                        cuckoo_get(ck, 1, &val) && val == -1 &&
+                        !cuckoo_get(ck, 2, &val));
+    wal_close(wal_lin);
+    wal_close(wal_ck);
+    linear_destroy(lin);
+    cuckoo_destroy(ck);
+    
+    // Test 3: A torn record at the end is dropped and cut from the file,
+    // so records appended afterwards replay too
+    FILE *f = fopen(path, "ab");
+    if (f) {
+        fwrite("\x31TUP\x07", 1, 5, f);  // Start of a record cut short by a crash
+        fclose(f);
+    }
+    ch = chained_create(16);
+    wal = wal_open(path, ch, &wal_chained_ops, NULL);
+    bool replayed = wal && wal_replay_count(wal) == 15001;
+    wal_put(wal, 0, 7);
+    wal_close(wal);
+    chained_destroy(ch);
+    ch = chained_create(16);
+    wal = wal_open(path, ch, &wal_chained_ops, NULL);
+    TEST_ASSERT(result, f && replayed && wal_replay_count(wal) == 15002 &&
+                        chained_get(ch, 0, &val) && val == 7);
+    wal_close(wal);
+    chained_destroy(ch);
+    remove(path);
+    
+    // Test 4: Records are committed in groups of commit_bytes, or one by
+    // one when the group holds a single record
+    WalOptions opts = {0};
+    opts.commit_bytes = 64 * WAL_RECORD_SIZE;
+    opts.commit_ms = -1;  // Bytes only, so the count is exact
+    ch = chained_create(16);
+    wal = wal_open(path, ch, &wal_chained_ops, &opts);
+    for (int i = 0; i < 640; i++) wal_put(wal, i, i);
+    size_t grouped = wal_commit_count(wal);
+    wal_put(wal, 640, 640);
+    wal_commit(wal);
+    wal_close(wal);
+    opts.commit_bytes = 1;  // Rounded up to one record
+    wal = wal_open(path, ch, &wal_chained_ops, &opts);
+    for (int i = 0; i < 10; i++) wal_put(wal, i, i);
+    TEST_ASSERT(result, grouped == 10 && wal_commit_count(wal) == 10 &&
+                        wal_replay_count(wal) == 641);
+    wal_close(wal);
+    chained_destroy(ch);
+    remove(path);
+    
+    // Test 5: A commit cut short by a full disk (a file size limit here)
+    // is undone and retried, so no durable record sits behind a torn one
+    opts.commit_bytes = 4 * WAL_RECORD_SIZE;
+    ch = chained_create(64);
+    wal = wal_open(path, ch, &wal_chained_ops, &opts);
+    for (int i = 0; i < 4; i++) wal_put(wal, i, i);  // First commit
+    struct rlimit saved, cap;
+    bool limited = getrlimit(RLIMIT_FSIZE, &saved) == 0;
+    void (*old_handler)(int) = signal(SIGXFSZ, SIG_IGN);  // EFBIG, not a kill
+    cap = saved;
+    cap.rlim_cur = 4 * WAL_RECORD_SIZE + 40;  // Room for 2.5 more records
+    limited = limited && setrlimit(RLIMIT_FSIZE, &cap) == 0;
+    for (int i = 4; i < 7; i++) wal_put(wal, i, i);
+    bool refused = !wal_put(wal, 7, 7) &&           // Applied, commit failed
+                   !wal_put(wal, 8, 8) && !chained_get(ch, 8, &val);  // No room
+    if (limited) setrlimit(RLIMIT_FSIZE, &saved);
+    signal(SIGXFSZ, old_handler);
+    bool retried = wal_put(wal, 9, 9) && wal_commit_count(wal) == 2;
+    wal_close(wal);
+    chained_destroy(ch);
+    ch = chained_create(64);
+    wal = wal_open(path, ch, &wal_chained_ops, NULL);
+    TEST_ASSERT(result, limited && refused && retried &&
+                        wal_replay_count(wal) == 9 && chained_size(ch) == 9 &&
+                        chained_get(ch, 9, &val) && !chained_get(ch, 8, &val));
+    wal_close(wal);
+    chained_destroy(ch);
+    remove(path);
+    
+    // Test 6: Opening fails when the map cannot store every record
+    ch = chained_create(16);
+    wal = wal_open(path, ch, &wal_chained_ops, NULL);
+    for (int i = 0; i < 100; i++) wal_put(wal, i, i);
+    wal_close(wal);
+    chained_destroy(ch);
+    lin = linear_create(10);  // Fixed capacity, never grows
+    wal_lin = wal_open(path, lin, &wal_linear_ops, NULL);
+    TEST_ASSERT(result, !wal_lin && linear_size(lin) == 10);
+    wal_close(wal_lin);
+    linear_destroy(lin);
+    remove(path);
+    
+    // Test 7: wal_tick commits an idle buffer once the interval passes
+    opts.commit_bytes = 0;
+    opts.commit_ms = 60000;  // Never reached by the appends below
+    ch = chained_create(16);
+    wal = wal_open(path, ch, &wal_chained_ops, &opts);
+    wal_put(wal, 1, 1);
+    bool early = wal_tick(wal) && wal_commit_count(wal) == 0;
+    wal->last_commit_ms -= opts.commit_ms;  // As if a minute went by idle
+    TEST_ASSERT(result, early && wal_tick(wal) && wal_commit_count(wal) == 1 &&
+                        wal_tick(wal) && wal_commit_count(wal) == 1);
+    wal_close(wal);
+    chained_destroy(ch);
+    remove(path);
+    
+    // Test 8: A log reopens into maps that differ from the writer: a key
+    // re-put past its own tombstone is logged once and replays under
+    // another seed, and deletes of keys a cache already evicted are skipped
+    LinearOptions seeded = {0};
+    seeded.seed = 1;
+    lin = linear_create_with(64, &seeded);
+    wal_lin = wal_open(path, lin, &wal_linear_ops, NULL);
+    wal_put(wal_lin, 0, 1);
+    int past = 1;  // A key whose probe path runs through key 0's slot
+    while (linear_probe_count(lin, past) != 2) past++;
+    wal_put(wal_lin, past, 2);
+    wal_delete(wal_lin, 0);
+    wal_put(wal_lin, past, 3);
+    bool deleted = wal_delete(wal_lin, past) && !wal_delete(wal_lin, past);
+    wal_close(wal_lin);
+    linear_destroy(lin);
+    seeded.seed = 2;
+    lin = linear_create_with(64, &seeded);
+    wal_lin = wal_open(path, lin, &wal_linear_ops, NULL);
+    bool reseeded = deleted && wal_lin && wal_replay_count(wal_lin) == 5 &&
+                    linear_size(lin) == 0 && !linear_get(lin, past, &val);
+    wal_close(wal_lin);
+    linear_destroy(lin);
+    LinearOptions cache_opts = {0};
+    cache_opts.cache = CACHE_CLOCK;
+    lin = linear_create_with(1, &cache_opts);  // past evicts 0 before its delete
+    wal_lin = wal_open(path, lin, &wal_linear_ops, NULL);
+    TEST_ASSERT(result, reseeded && wal_lin && wal_replay_count(wal_lin) == 5 &&
+                        linear_size(lin) == 0);
+    wal_close(wal_lin);
+    linear_destroy(lin);
+    remove(path);
+    
+    printf("  Write-Ahead Log: %d/%d tests passed\n", result.passed, result.total);
+    return result;
+}
+
+// Test the macro-generated maps, including non-int key and value types
+TestResult test_template_correctness(void) {
+    TestResult result = {0, 0};
+    int val;
+    
+    printf("Testing Template HashMaps...\n");
+    
+    // Test 1: Chained instantiation put/update/get/delete
+    TplChained *ch = TplChained_create(16);
+    for (int i = 0; i < 100; i++) TplChained_put(ch, i, i);
+    TplChained_put(ch, 5, 500);
+    TplChained_delete(ch, 6);
+    TEST_ASSERT(result, TplChained_size(ch) == 99 &&
+                        TplChained_get(ch, 5, &val) && val == 500 &&
+                        !TplChained_get(ch, 6, &val));
+    TplChained_destroy(ch);
+    
+    // Test 2: Linear instantiation, tombstones keep later keys reachable
+    TplLinear *lh = TplLinear_create(200);
+    for (int i = 0; i < 100; i++) TplLinear_put(lh, i, i * 2);
+    for (int i = 0; i < 100; i += 2) TplLinear_delete(lh, i);
+    bool all_found = TplLinear_size(lh) == 50;
+    for (int i = 1; i < 100 && all_found; i += 2) {
+        all_found = TplLinear_get(lh, i, &val) && val == i * 2 &&
+                    !TplLinear_get(lh, i - 1, &val);
+    }
+    // Updating a key that sits past a tombstone keeps a single copy
+    TplCollide *co = TplCollide_create(4);
+    TplCollide_put(co, 1, 10);
+    TplCollide_put(co, 2, 20);
+    TplCollide_delete(co, 1);
+    TplCollide_put(co, 2, 99);
+    bool one_copy = TplCollide_size(co) == 1 &&
+                    TplCollide_get(co, 2, &val) && val == 99;
+    TplCollide_delete(co, 2);
+    TEST_ASSERT(result, all_found && one_copy && !TplCollide_get(co, 2, &val) &&
+                        TplCollide_size(co) == 0);
+    TplCollide_destroy(co);
+    TplLinear_destroy(lh);
+    
+    // Test 3: Cuckoo instantiation with uint64_t keys and double values
+    // grows from 4 slots and keeps every pair
+    TplCuckoo *cu = TplCuckoo_create(4);
+    double d;
+    for (uint64_t i = 0; i < 2000; i++) {
+        TplCuckoo_put(cu, i << 33, (double)i / 2);  // Only the high half differs
+    }
+    all_found = TplCuckoo_size(cu) == 2000;
+    for (uint64_t i = 0; i < 2000 && all_found; i++) {
+        all_found = TplCuckoo_get(cu, i << 33, &d) && d == (double)i / 2;
+    }
+    TEST_ASSERT(result, all_found && TplCuckoo_delete(cu, (uint64_t)7 << 33) &&
+                        !TplCuckoo_get(cu, (uint64_t)7 << 33, &d) &&
+                        !TplCuckoo_get(cu, 7, &d));
+    TplCuckoo_destroy(cu);
+    
+    printf("  Templates: %d/%d tests passed\n", result.passed, result.total);
+    return result;
+}
+
 // Stress test chained hash map with n elements
 TestResult test_chained_stress(int n) {
     TestResult result = {0, 0};
@@ -176,6 +1179,16 @@ TestResult test_chained_stress(int n) {
     }
     TEST_ASSERT(result, found == n);  // All lookups should succeed
     
+    // Histogram covers every bucket and agrees with the max chain length
+    size_t hist[16], buckets = 0, nodes = 0;
+    size_t longest = chained_chain_histogram(map, hist, 16);
+    for (size_t k = 0; k < 16; k++) {
+        buckets += hist[k];
+        nodes += k * hist[k];
+    }
+    TEST_ASSERT(result, buckets == (size_t)n / 2 && nodes == chained_size(map) &&
+                        longest == (size_t)chained_max_chain_length(map));
+    
     chained_destroy(map);
     free(keys);
     printf("  Stress: %d/%d tests passed\n", result.passed, result.total);
@@ -205,6 +1218,17 @@ TestResult test_linear_stress(int n) {
     }
     TEST_ASSERT(result, found == n);
     
+    // Hit histogram counts every key, miss histogram every slot
+    size_t hits[64], misses[64], hit_total = 0, miss_total = 0;
+    linear_probe_histogram(map, hits, misses, 64);
+    for (size_t k = 0; k < 64; k++) {
+        hit_total += hits[k];
+        miss_total += misses[k];
+    }
+    TEST_ASSERT(result, hit_total == linear_size(map) &&
+                        miss_total == (size_t)n * 2 &&
+                        hits[1] > 0 && misses[1] == (size_t)n * 2 - linear_size(map));
+    
     linear_destroy(map);
     free(keys);
     printf("  Stress: %d/%d tests passed\n", result.passed, result.total);
@@ -237,6 +1261,11 @@ TestResult test_cuckoo_stress(int n) {
     // Check rehash count is reasonable
     TEST_ASSERT(result, cuckoo_rehash_count(map) < 10);
     
+    // Every key resides in exactly one of the two tables
+    size_t tables[2];
+    cuckoo_table_histogram(map, tables, 2);
+    TEST_ASSERT(result, tables[0] + tables[1] == cuckoo_size(map));
+    
     cuckoo_destroy(map);
     free(keys);
     printf("  Stress: %d/%d tests passed (rehashes: %d)\n", 
@@ -244,6 +1273,41 @@ TestResult test_cuckoo_stress(int n) {
     return result;
 }
 
+// Stress test hopscotch hash map with n elements
+TestResult test_hopscotch_stress(int n) {
+    TestResult result = {0, 0};
+    
+    printf("Stress testing Hopscotch HashMap with %d elements...\n", n);
+    HopscotchHashMap *map = hopscotch_create(n);  // Grows near full
+    int *keys = generate_random_keys(n);
+    
+    // Insert all keys
+    for (int i = 0; i < n; i++) {
+        hopscotch_put(map, keys[i], i);
+    }
+    
+    TEST_ASSERT(result, hopscotch_size(map) <= (size_t)n);
+    
+    // Verify all keys retrievable within the neighborhood bound
+    int val;
+    int found = 0;
+    int max_probes = 0;
+    for (int i = 0; i < n; i++) {
+        if (hopscotch_get(map, keys[i], &val)) found++;
+        int probes = hopscotch_probe_count(map, keys[i]);
+        if (probes > max_probes) max_probes = probes;
+    }
+    TEST_ASSERT(result, found == n);
+    TEST_ASSERT(result, max_probes <= HOPSCOTCH_NEIGHBORHOOD);
+    
+    int resizes = hopscotch_resize_count(map);
+    hopscotch_destroy(map);
+    free(keys);
+    printf("  Stress: %d/%d tests passed (resizes: %d)\n",
+           result.passed, result.total, resizes);
+    return result;
+}
+
 // Run all correctness tests
 TestResult run_all_correctness_tests(void) {
     TestResult total = {0, 0};
@@ -260,6 +1324,24 @@ TestResult run_all_correctness_tests(void) {
     // Cuckoo tests
     r = test_cuckoo_correctness();
     total.passed += r.passed; total.total += r.total;
+    // Hopscotch tests
+    r = test_hopscotch_correctness();
+    total.passed += r.passed; total.total += r.total;
+    // Structure-of-arrays linear probing tests
+    r = test_linear_soa_correctness();
+    total.passed += r.passed; total.total += r.total;
+    // Unrolled chained tests
+    r = test_chained_unrolled_correctness();
+    total.passed += r.passed; total.total += r.total;
+    // Cuckoo filter tests
+    r = test_cuckoo_filter_correctness();
+    total.passed += r.passed; total.total += r.total;
+    // Write-ahead log tests
+    r = test_wal_correctness();
+    total.passed += r.passed; total.total += r.total;
+    // Macro-generated template maps
+    r = test_template_correctness();
+    total.passed += r.passed; total.total += r.total;
     
     // Stress tests
     print_subsection("Stress Tests");
@@ -272,6 +1354,9 @@ TestResult run_all_correctness_tests(void) {
     // Cuckoo stress test
     r = test_cuckoo_stress(DEFAULT_TEST_SIZE);
     total.passed += r.passed; total.total += r.total;
+    // Hopscotch stress test
+    r = test_hopscotch_stress(DEFAULT_TEST_SIZE);
+    total.passed += r.passed; total.total += r.total;
     // Summary
     printf("\nTotal: %d/%d correctness tests passed\n", total.passed, total.total);
     return total;
@@ -23,10 +23,17 @@ TestResult run_all_correctness_tests(void);
 TestResult test_chained_correctness(void);
 TestResult test_linear_correctness(void);
 TestResult test_cuckoo_correctness(void);
+TestResult test_hopscotch_correctness(void);
+TestResult test_linear_soa_correctness(void);
+TestResult test_chained_unrolled_correctness(void);
+TestResult test_cuckoo_filter_correctness(void);
+TestResult test_wal_correctness(void);
+TestResult test_template_correctness(void);
 
 // Stress tests with many elements
 TestResult test_chained_stress(int n);
 TestResult test_linear_stress(int n);
 TestResult test_cuckoo_stress(int n);
+TestResult test_hopscotch_stress(int n);
 
 #endif
\ No newline at end of file
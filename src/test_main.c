@@ -12,6 +12,7 @@
 #include "test_utils.h"
 #include "test_correctness.h"
 #include "test_benchmarks.h"
+#include "test_threads.h"
 
 // Print usage information
 static void print_usage(const char *program_name) {
@@ -22,6 +23,12 @@ static void print_usage(const char *program_name) {
     printf("  --benchmarks  Run only benchmark tests\n");
     printf("  --size N      Set test size (default: %d)\n", DEFAULT_TEST_SIZE);
     printf("  --capacity N  Set initial capacity (default: %d)\n", DEFAULT_CAPACITY);
+    printf("  --hugepages N Compare huge page allocation with N slots per map\n");
+    printf("  --seed N      Fix key and hash seeds for reproducible runs\n");
+    printf("  --sweep MB    Sweep table sizes up to MB megabytes, ns/op as CSV\n");
+    printf("  --csv FILE    Write the --sweep CSV to FILE instead of stdout\n");
+    printf("  --threads N   Lookup throughput and resize time on 1..N threads (--size keys)\n");
+    printf("  --interleave MB Interleaved chained lookups in an MB megabyte table\n");
     printf("  --help        Show this help message\n");
 }
 
@@ -31,6 +38,12 @@ int main(int argc, char *argv[]) {
     int run_benchmarks = 1;
     int test_size = DEFAULT_TEST_SIZE;
     size_t capacity = DEFAULT_CAPACITY;
+    size_t hugepage_slots = 0;  // 0 = skip the huge page benchmark
+    unsigned long long seed = 0;  // 0 = seed from the clock
+    size_t sweep_mb = 0;          // 0 = skip the memory hierarchy sweep
+    const char *csv_path = NULL;  // NULL = sweep CSV on stdout
+    int max_threads = 0;          // 0 = skip the threaded lookup and resize benchmarks
+    size_t interleave_mb = 0;     // 0 = skip the large interleaved lookup run
     // Parse command line arguments
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--help") == 0) {
@@ -49,6 +62,26 @@ int main(int argc, char *argv[]) {
             test_size = atoi(argv[++i]);
         } else if (strcmp(argv[i], "--capacity") == 0 && i + 1 < argc) {
             capacity = (size_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--hugepages") == 0 && i + 1 < argc) {
+            hugepage_slots = (size_t)atoll(argv[++i]);
+            run_correctness = 0;
+            run_benchmarks = 0;
+        } else if (strcmp(argv[i], "--sweep") == 0 && i + 1 < argc) {
+            sweep_mb = (size_t)atoll(argv[++i]);
+            run_correctness = 0;
+            run_benchmarks = 0;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            max_threads = atoi(argv[++i]);
+            run_correctness = 0;
+            run_benchmarks = 0;
+        } else if (strcmp(argv[i], "--interleave") == 0 && i + 1 < argc) {
+            interleave_mb = (size_t)atoll(argv[++i]);
+            run_correctness = 0;
+            run_benchmarks = 0;
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv_path = argv[++i];
         } else {
             printf("Unknown option: %s\n", argv[i]);
             print_usage(argv[0]);
@@ -62,9 +95,10 @@ int main(int argc, char *argv[]) {
     printf("   Hash Map Implementation Test Suite\n");
     printf("========================================\n");
     printf("Test size: %d | Capacity: %zu\n", test_size, capacity);
+    if (seed) printf("Seed: %llu\n", seed);
     
-    // Seed random number generator
-    srand((unsigned int)time(NULL));
+    // Seed key generation and benchmark maps
+    set_benchmark_seed(seed);
     
     // Run selected tests
     if (run_correctness) {
@@ -79,6 +113,23 @@ int main(int argc, char *argv[]) {
         run_all_benchmarks(test_size, capacity);
     }
     
+    if (hugepage_slots > 0) {
+        benchmark_hugepages(hugepage_slots);
+    }
+    
+    if (sweep_mb > 0) {
+        benchmark_memory_sweep(sweep_mb, csv_path);
+    }
+    
+    if (max_threads > 0) {
+        benchmark_threaded_lookups(test_size, max_threads);
+        benchmark_parallel_resize(test_size, max_threads);
+    }
+    
+    if (interleave_mb > 0) {
+        benchmark_interleaved(interleave_mb);
+    }
+    
     // Print footer
     printf("\n========================================\n");
     printf("   Test Suite Complete\n");
@@ -0,0 +1,161 @@
+/*
+ * Hardware Performance Counters Implementation
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * Counters are read through the Linux perf_event_open(2) interface.
+ * Each event is opened on its own (not as a group) so that a single
+ * unsupported event, common in VMs and containers, does not disable
+ * the rest. Multiplexed readings are scaled by time_enabled/time_running.
+ * On other platforms, or when perf_event_paranoid forbids access,
+ * every sample is reported as unavailable and benchmarks print ms only.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE // Needed for syscall() under -std=c99
+#endif
+
+#include "test_perf.h"
+#include <stdio.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdint.h>
+
+// File descriptor for each counter, -1 if unavailable
+static int perf_fds[PERF_NUM_COUNTERS] = {-1, -1, -1, -1, -1, -1};
+
+// Build a hardware cache event config (cache id, op, result)
+#define CACHE_EVENT(cache, op, result) \
+    ((cache) | ((op) << 8) | ((result) << 16))
+
+// Event type and config for each PerfCounterId
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} perf_events[PERF_NUM_COUNTERS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, CACHE_EVENT(PERF_COUNT_HW_CACHE_L1D,
+                                     PERF_COUNT_HW_CACHE_OP_READ,
+                                     PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, CACHE_EVENT(PERF_COUNT_HW_CACHE_DTLB,
+                                     PERF_COUNT_HW_CACHE_OP_READ,
+                                     PERF_COUNT_HW_CACHE_RESULT_MISS)},
+};
+
+// Thin wrapper, glibc does not export perf_event_open
+static int perf_event_open(struct perf_event_attr *attr) {
+    // Measure this process on any CPU
+    return (int)syscall(SYS_perf_event_open, attr, 0, -1, -1, 0);
+}
+
+// Open the counters once before benchmarking
+bool perf_init(void) {
+    bool any = false;
+    for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+        if (perf_fds[i] >= 0) { // Already open
+            any = true;
+            continue;
+        }
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = perf_events[i].type;
+        attr.config = perf_events[i].config;
+        attr.disabled = 1;        // Enabled explicitly by perf_start
+        attr.exclude_kernel = 1;  // User space only (paranoid level 2)
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+        perf_fds[i] = perf_event_open(&attr);
+        if (perf_fds[i] >= 0) any = true;
+    }
+    if (!any) {
+        printf("Hardware counters unavailable (perf_event_open failed), "
+               "reporting time only\n");
+    }
+    return any;
+}
+
+// Close all counters opened by perf_init
+void perf_shutdown(void) {
+    for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+        if (perf_fds[i] >= 0) close(perf_fds[i]);
+        perf_fds[i] = -1;
+    }
+}
+
+// Reset and enable all open counters
+void perf_start(void) {
+    for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+        if (perf_fds[i] < 0) continue;
+        ioctl(perf_fds[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(perf_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+// Disable counters and return readings divided by ops
+PerfSample perf_stop(int ops) {
+    PerfSample s;
+    memset(&s, 0, sizeof(s));
+
+    // Stop everything first so reads do not count each other
+    for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+        if (perf_fds[i] >= 0) ioctl(perf_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+        if (perf_fds[i] < 0 || ops <= 0) continue;
+        uint64_t buf[3];  // value, time_enabled, time_running
+        if (read(perf_fds[i], buf, sizeof(buf)) != (ssize_t)sizeof(buf)) continue;
+        if (buf[2] == 0) continue;  // Never scheduled on the PMU
+
+        // Scale up if the kernel multiplexed this counter
+        double value = (double)buf[0] * ((double)buf[1] / (double)buf[2]);
+        s.per_op[i] = value / ops;
+        s.valid[i] = true;
+    }
+    return s;
+}
+
+#else // Not Linux: counters are never available
+
+bool perf_init(void) {
+    printf("Hardware counters unavailable on this platform, "
+           "reporting time only\n");
+    return false;
+}
+
+void perf_shutdown(void) {}
+
+void perf_start(void) {}
+
+PerfSample perf_stop(int ops) {
+    (void)ops;
+    PerfSample s = {{0}, {false}};
+    return s;
+}
+
+#endif
+
+// Print the available per-op counters of a sample on the current line
+void perf_print_sample(PerfSample s) {
+    static const char *labels[PERF_NUM_COUNTERS] = {
+        "cyc", "ins", "L1m", "LLCm", "brm", "dTLBm"
+    };
+    bool any = false;
+    for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+        if (!s.valid[i]) continue;
+        printf("%s %s/op %.2f", any ? "," : "  [", labels[i], s.per_op[i]);
+        any = true;
+    }
+    if (any) printf("]");
+}
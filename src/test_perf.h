@@ -0,0 +1,47 @@
+/*
+ * Hardware Performance Counters Header
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ */
+
+#ifndef TEST_PERF_H // Include guard
+#define TEST_PERF_H // Prevent multiple inclusions
+
+#include <stdbool.h>
+
+// Hardware events sampled around each timed benchmark section
+typedef enum {
+    PERF_CYCLES,         // CPU cycles
+    PERF_INSTRUCTIONS,   // Retired instructions
+    PERF_L1D_MISSES,     // L1 data cache read misses
+    PERF_LLC_MISSES,     // Last level cache misses
+    PERF_BRANCH_MISSES,  // Mispredicted branches
+    PERF_DTLB_MISSES,    // Data TLB read misses
+    PERF_NUM_COUNTERS    // Number of counters (not an event)
+} PerfCounterId;
+
+// Counter readings for one timed section, normalized per operation
+typedef struct {
+    double per_op[PERF_NUM_COUNTERS]; // Event count divided by operation count
+    bool valid[PERF_NUM_COUNTERS];    // Whether the counter could be read
+} PerfSample;
+
+// Open the counters once before benchmarking
+// Returns true if at least one counter is available
+bool perf_init(void);
+
+// Close all counters opened by perf_init
+void perf_shutdown(void);
+
+// Reset and enable all open counters
+void perf_start(void);
+
+// Disable counters and return readings divided by ops
+// Returns an all-invalid sample when counters are unavailable
+PerfSample perf_stop(int ops);
+
+// Print the available per-op counters of a sample on the current line
+void perf_print_sample(PerfSample s);
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * Benchmark Thread Helpers Implementation
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * Threads are POSIX threads. On Linux each one is pinned with
+ * pthread_setaffinity_np so that thread counts map to distinct cores and
+ * runs are repeatable; elsewhere the scheduler places them. A start gate
+ * (mutex + condition variable, available everywhere unlike barriers)
+ * keeps early threads from running alone while later ones are created.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE // pthread_setaffinity_np, CPU_SET
+#else
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "test_threads.h"
+#include <pthread.h>
+#include <unistd.h>
+
+// Start gate shared by the threads of one run
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t open;
+    int waiting;  // Threads that have not reached the gate yet
+} StartGate;
+
+// Per thread launch record
+typedef struct {
+    StartGate *gate;
+    void (*worker)(void *arg);
+    void *arg;
+    int cpu;  // CPU to pin to
+} ThreadLaunch;
+
+// Number of online CPUs (1 if unknown)
+int thread_cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+// Pin the calling thread to one CPU (no-op where unsupported)
+static void pin_self(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);  // Best effort
+#else
+    (void)cpu;
+#endif
+}
+
+// Thread entry: pin, wait for every thread to arrive, run the worker
+static void* thread_main(void *p) {
+    ThreadLaunch *launch = p;
+    pin_self(launch->cpu);
+    
+    StartGate *gate = launch->gate;
+    pthread_mutex_lock(&gate->lock);
+    if (--gate->waiting == 0) {
+        pthread_cond_broadcast(&gate->open);  // Last one in opens the gate
+    }
+    while (gate->waiting > 0) {
+        pthread_cond_wait(&gate->open, &gate->lock);
+    }
+    pthread_mutex_unlock(&gate->lock);
+    
+    launch->worker(launch->arg);
+    return NULL;
+}
+
+// Run worker on nthreads pinned threads and wait for all of them
+bool run_pinned_threads(int nthreads, void (*worker)(void *arg), void *args,
+                        size_t arg_size) {
+    if (nthreads < 1 || nthreads > MAX_BENCH_THREADS || !worker) return false;
+    
+    pthread_t threads[MAX_BENCH_THREADS];
+    ThreadLaunch launch[MAX_BENCH_THREADS];
+    StartGate gate;
+    pthread_mutex_init(&gate.lock, NULL);
+    pthread_cond_init(&gate.open, NULL);
+    gate.waiting = nthreads;
+    
+    int cpus = thread_cpu_count();
+    int started = 0;
+    for (int t = 0; t < nthreads; t++) {
+        launch[t].gate = &gate;
+        launch[t].worker = worker;
+        launch[t].arg = (char *)args + (size_t)t * arg_size;
+        launch[t].cpu = t % cpus;
+        if (pthread_create(&threads[t], NULL, thread_main, &launch[t]) != 0) {
+            break;
+        }
+        started++;
+    }
+    
+    // A failed create would leave the others at the gate: release them
+    if (started < nthreads) {
+        pthread_mutex_lock(&gate.lock);
+        gate.waiting = 0;
+        pthread_cond_broadcast(&gate.open);
+        pthread_mutex_unlock(&gate.lock);
+    }
+    
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    pthread_cond_destroy(&gate.open);
+    pthread_mutex_destroy(&gate.lock);
+    return started == nthreads;
+}
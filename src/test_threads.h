@@ -0,0 +1,27 @@
+/*
+ * Benchmark Thread Helpers Header
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ */
+
+#ifndef TEST_THREADS_H // Include guard
+#define TEST_THREADS_H // Prevent multiple inclusions
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Upper bound on threads started by one run_pinned_threads call
+#define MAX_BENCH_THREADS 256
+
+// Number of online CPUs (1 if unknown)
+int thread_cpu_count(void);
+
+// Run worker(args + t * arg_size) on nthreads threads, thread t pinned to
+// CPU t % thread_cpu_count() where supported. All threads are released
+// together once every thread has started, and the call returns after all
+// of them finish. Returns false if a thread could not be created
+bool run_pinned_threads(int nthreads, void (*worker)(void *arg), void *args,
+                        size_t arg_size);
+
+#endif
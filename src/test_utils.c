@@ -5,16 +5,36 @@
  * Class: CS 5008
  */
 
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 199309L // clock_gettime under -std=c99
+#endif
+
 #include "test_utils.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 #include <time.h>
 
+// Seed shared by all benchmarks, 0 means not fixed
+static unsigned long long bench_seed = 0;
+
 // Get current time in milliseconds for benchmarking
 double get_time_ms(void) {
     return (double)clock() / CLOCKS_PER_SEC * 1000.0;
 }
 
+// Get a monotonic wall clock reading in nanoseconds
+// clock() only has microsecond resolution and counts CPU time
+double get_time_ns(void) {
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#else
+    return (double)clock() / CLOCKS_PER_SEC * 1e9;
+#endif
+}
+
 // Generate array of n random keys
 int* generate_random_keys(int n) {
     int *keys = malloc(n * sizeof(int));
@@ -37,6 +57,100 @@ int* generate_sequential_keys(int n) {
     return keys;
 }
 
+// Key for counter c
+// Odd multiplies and xorshifts are bijections, so keys never repeat and
+// non-overlapping counter ranges never share a key
+static int distinct_key(unsigned int c) {
+    unsigned int k = c * 0x9e3779b1U;
+    k ^= (k >> 15);
+    k *= 0x2c1b3c6dU;
+    k ^= (k >> 12);
+    return (int)k;
+}
+
+// Generate n distinct keys from the counters first, first + 1, ...
+int* generate_distinct_keys(int n, unsigned int first) {
+    int *keys = malloc((size_t)n * sizeof(int));
+    if (!keys) return NULL;  // Handle allocation failure
+    
+    for (int i = 0; i < n; i++) {
+        keys[i] = distinct_key(first + (unsigned int)i);
+    }
+    return keys;
+}
+
+// Generate n Zipf(s) distributed keys over universe distinct keys
+// Inverts the cumulative distribution with a binary search per draw
+int* generate_zipf_keys(int n, int universe, double s) {
+    if (universe < 1) return NULL;
+    int *keys = malloc((size_t)n * sizeof(int));
+    double *cdf = malloc((size_t)universe * sizeof(double));
+    if (!keys || !cdf) {
+        free(keys);
+        free(cdf);
+        return NULL;  // Handle allocation failure
+    }
+    
+    // Cumulative weights of ranks 1 .. universe
+    double total = 0.0;
+    for (int r = 0; r < universe; r++) {
+        total += 1.0 / pow((double)(r + 1), s);
+        cdf[r] = total;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        // Two rand() calls give enough resolution for the long tail
+        double u = ((double)rand() * ((double)RAND_MAX + 1.0) + rand()) /
+                   (((double)RAND_MAX + 1.0) * ((double)RAND_MAX + 1.0));
+        double target = u * total;
+        int lo = 0, hi = universe - 1;
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (cdf[mid] < target) lo = mid + 1;
+            else hi = mid;
+        }
+        keys[i] = distinct_key((unsigned int)lo);
+    }
+    free(cdf);
+    return keys;
+}
+
+// Invert the MurmurHash3 fmix32 finalizer used by the maps
+// Each step is a bijection: xorshifts undo by repeating, multiplies
+// by the modular inverse of the constant
+static unsigned int fmix32_inverse(unsigned int k) {
+    k ^= (k >> 16);
+    k *= 0x7ed1b41dU;                 // Inverse of 0xc2b2ae35
+    k ^= (k >> 13) ^ (k >> 26);
+    k *= 0xa5cb9243U;                 // Inverse of 0x85ebca6b
+    k ^= (k >> 16);
+    return k;
+}
+
+// Generate n distinct keys that all hash to slot 0
+int* generate_colliding_keys(int n, unsigned int seed, size_t capacity) {
+    int *keys = malloc(n * sizeof(int));
+    if (!keys) return NULL;  // Handle allocation failure
+    
+    // Hash values 0, capacity, 2 * capacity, ... all reduce to slot 0
+    for (int i = 0; i < n; i++) {
+        unsigned int h = (unsigned int)((size_t)i * capacity);
+        keys[i] = (int)(fmix32_inverse(h) ^ seed);
+    }
+    return keys;
+}
+
+// Fix the seed used for key generation and map hash seeds
+void set_benchmark_seed(unsigned long long seed) {
+    bench_seed = seed;
+    srand(seed ? (unsigned int)seed : (unsigned int)time(NULL));  // Key generator
+}
+
+// Seed passed to maps created by benchmarks
+unsigned long long benchmark_seed(void) {
+    return bench_seed;
+}
+
 // Print a section header for test output
 void print_section_header(const char *title) {
     printf("\n=== %s ===\n\n", title);
@@ -17,6 +17,9 @@
 // Get current time in milliseconds for benchmarking
 double get_time_ms(void);
 
+// Get a monotonic wall clock reading in nanoseconds
+double get_time_ns(void);
+
 // Generate array of n random keys
 // Caller is responsible for freeing returned array
 int* generate_random_keys(int n);
@@ -25,6 +28,30 @@ int* generate_random_keys(int n);
 // Caller is responsible for freeing returned array
 int* generate_sequential_keys(int n);
 
+// Generate n distinct pseudo random keys from counters first .. first + n - 1
+// Calls with disjoint counter ranges produce disjoint keys (hit/miss sets)
+// Caller is responsible for freeing returned array
+int* generate_distinct_keys(int n, unsigned int first);
+
+// Generate n keys drawn with Zipf(s) popularity from universe distinct keys
+// Rank r (1 = hottest) has probability proportional to 1 / r^s and is the
+// key generate_distinct_keys(universe, 0) puts at index r - 1
+// Caller is responsible for freeing returned array
+int* generate_zipf_keys(int n, int universe, double s);
+
+// Generate n distinct keys that all hash to slot 0 of a table with
+// capacity slots under the maps' fmix32(key ^ seed) % capacity hash
+// Models an attacker who knows the hash seed (capacity <= 2^32 / n)
+// Caller is responsible for freeing returned array
+int* generate_colliding_keys(int n, unsigned int seed, size_t capacity);
+
+// Fix the seed used for benchmark key generation and map hash seeds
+// 0 (the default) keeps time based seeding
+void set_benchmark_seed(unsigned long long seed);
+
+// Seed passed to maps created by benchmarks (0 = let the map choose)
+unsigned long long benchmark_seed(void);
+
 // Print a section header for test output
 void print_section_header(const char *title);
 
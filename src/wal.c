@@ -0,0 +1,346 @@
+/*
+ * Write-Ahead Log Implementation
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ *
+ * Every put and delete that reaches the map is appended to a log file as
+ * a fixed size record. Records are buffered and made durable in groups
+ * (group commit): one write and one fdatasync once commit_bytes are
+ * buffered or commit_ms have passed since the last commit, so the cost of
+ * a disk flush is shared by every operation in the group. Operations
+ * after the last commit are lost if the process or machine dies. There
+ * is no timer thread: the interval is checked on each append and by
+ * wal_tick, which an idle caller drives so the last group still commits.
+ *
+ * Opening a log replays it into an empty map: runs of puts go through the
+ * map's put_batch bulk-load path, deletes are applied in order between
+ * them. Each record carries a checksum, so a record torn by a crash ends
+ * the replay and is cut from the file before new records are appended.
+ * A commit that fails partway is cut back the same way, so a record torn
+ * by a full disk never sits in front of later, durable records.
+ * A map that cannot take every record (chained and linear maps do not
+ * grow on put) makes the open fail rather than lose records silently.
+ * A logged delete whose key the replayed map does not hold is skipped:
+ * the map need not match the one that wrote the log (another seed, or
+ * cache evictions that fall differently).
+ */
+
+#define _POSIX_C_SOURCE 200112L // fdatasync, ftruncate, clock_gettime
+
+#include "wal.h"
+#include "chained.h"
+#include "linear_probing.h"
+#include "cuckoo.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+// Record types, chosen so a zeroed record never passes as valid
+#define WAL_PUT 0x50555431u     // "PUT1"
+#define WAL_DELETE 0x44454c31u  // "DEL1"
+
+// Bytes read from the file at a time during replay (whole records)
+#define WAL_READ_BYTES (WAL_RECORD_SIZE * 4096)
+
+// Adapters from the generic operations to each map's functions
+static bool chained_put_op(void *map, int key, int value) {
+    return chained_put(map, key, value);
+}
+static bool chained_delete_op(void *map, int key) {
+    return chained_delete(map, key);
+}
+static size_t chained_put_batch_op(void *map, const int *keys,
+                                   const int *values, size_t n) {
+    return chained_put_batch(map, keys, values, n);
+}
+static bool linear_put_op(void *map, int key, int value) {
+    return linear_put(map, key, value);
+}
+static bool linear_delete_op(void *map, int key) {
+    return linear_delete(map, key);
+}
+static size_t linear_put_batch_op(void *map, const int *keys,
+                                  const int *values, size_t n) {
+    return linear_put_batch(map, keys, values, n);
+}
+static bool cuckoo_put_op(void *map, int key, int value) {
+    return cuckoo_put(map, key, value);
+}
+static bool cuckoo_delete_op(void *map, int key) {
+    return cuckoo_delete(map, key);
+}
+static size_t cuckoo_put_batch_op(void *map, const int *keys,
+                                  const int *values, size_t n) {
+    return cuckoo_put_batch(map, keys, values, n);
+}
+
+const WalMapOps wal_chained_ops = {chained_put_op, chained_delete_op,
+                                   chained_put_batch_op};
+const WalMapOps wal_linear_ops = {linear_put_op, linear_delete_op,
+                                  linear_put_batch_op};
+const WalMapOps wal_cuckoo_ops = {cuckoo_put_op, cuckoo_delete_op,
+                                  cuckoo_put_batch_op};
+
+/* Checksum mixing using MurmurHash-inspired bit mixing
+* Code adapted from Appleby, A. (2011). MurmurHash3 fmix32() finalizer.
+* Retrieved from https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp.
+* The bit-mixing sequence and associated constants in the hash_with_seed function
+* were adapted from the fmix32() finalizer of MurmurHash3.
+*/
+static uint32_t fmix32(uint32_t k) {
+    k ^= (k >> 16);      // Mix high bits down
+    k *= 0x85ebca6b;     // Multiply by magic constant
+    k ^= (k >> 13);      // More mixing
+    k *= 0xc2b2ae35;     // Another constant
+    k ^= (k >> 16);      // Final mix
+    return k;
+}
+
+// Checksum over the three data fields of a record
+static uint32_t record_checksum(uint32_t type, uint32_t key, uint32_t value) {
+    uint32_t h = fmix32(type);
+    h = fmix32(h ^ key);
+    return fmix32(h ^ value);
+}
+
+// Little-endian field access, so logs move between machines
+static void store_u32(unsigned char *p, uint32_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+static uint32_t load_u32(const unsigned char *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 |
+           (uint32_t)p[3] << 24;
+}
+
+// Monotonic clock in milliseconds, for the commit interval
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// Write all n bytes, retrying short writes and interrupts
+static bool write_all(int fd, const unsigned char *p, size_t n) {
+    while (n > 0) {
+        ssize_t w = write(fd, p, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += w;
+        n -= (size_t)w;
+    }
+    return true;
+}
+
+// Read up to n bytes, stopping early only at end of file
+static ssize_t read_full(int fd, unsigned char *p, size_t n) {
+    size_t got = 0;
+    while (got < n) {
+        ssize_t r = read(fd, p + got, n - got);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (r == 0) break;  // End of file
+        got += (size_t)r;
+    }
+    return (ssize_t)got;
+}
+
+// Apply pending puts through the bulk-load path
+// False if the map did not store all of them
+static bool flush_puts(Wal *wal, const int *keys, const int *values,
+                       size_t *pending) {
+    size_t n = *pending;
+    *pending = 0;
+    return n == 0 || wal->ops->put_batch(wal->map, keys, values, n) == n;
+}
+
+// Apply every valid record to the map, then cut anything after the last
+// one (a record torn by a crash) so new records follow valid ones
+// Fails on a read error or a put the map does not store; a delete of an
+// absent key is a no-op
+static bool wal_replay(Wal *wal) {
+    unsigned char *chunk = malloc(WAL_READ_BYTES);
+    int *keys = malloc(WAL_REPLAY_BATCH * sizeof(int));
+    int *values = malloc(WAL_REPLAY_BATCH * sizeof(int));
+    bool ok = chunk && keys && values;
+    off_t good = 0;      // File offset just past the last valid record
+    size_t pending = 0;  // Puts gathered for the next put_batch
+    bool torn = false;
+
+    while (ok && !torn) {
+        ssize_t got = read_full(wal->fd, chunk, WAL_READ_BYTES);
+        if (got < 0) {
+            ok = false;
+            break;
+        }
+        if (got == 0) break;  // End of log
+        for (ssize_t off = 0; off < got; off += WAL_RECORD_SIZE) {
+            if (got - off < WAL_RECORD_SIZE) {
+                torn = true;  // Partial record at the end
+                break;
+            }
+            const unsigned char *r = chunk + off;
+            uint32_t type = load_u32(r);
+            uint32_t key = load_u32(r + 4);
+            uint32_t value = load_u32(r + 8);
+            if ((type != WAL_PUT && type != WAL_DELETE) ||
+                load_u32(r + 12) != record_checksum(type, key, value)) {
+                torn = true;
+                break;
+            }
+            if (type == WAL_PUT) {
+                keys[pending] = (int)key;
+                values[pending++] = (int)value;
+                if (pending == WAL_REPLAY_BATCH) {
+                    ok = flush_puts(wal, keys, values, &pending);
+                }
+            } else {
+                // Earlier puts must land before the delete
+                ok = flush_puts(wal, keys, values, &pending);
+                if (ok) wal->ops->del(wal->map, (int)key);
+            }
+            if (!ok) break;
+            wal->replayed++;
+            good += WAL_RECORD_SIZE;
+        }
+    }
+    if (ok) ok = flush_puts(wal, keys, values, &pending);
+    if (ok && torn) ok = ftruncate(wal->fd, good) == 0;
+    wal->committed = (size_t)good;
+
+    free(chunk);
+    free(keys);
+    free(values);
+    return ok;
+}
+
+// Open or create the log at path and replay it into map
+Wal* wal_open(const char *path, void *map, const WalMapOps *ops,
+              const WalOptions *opts) {
+    if (!path || !map || !ops) return NULL;
+    Wal *wal = malloc(sizeof(Wal));
+    if (!wal) return NULL;
+
+    // Buffer holds whole records, at least one
+    size_t bytes = (opts && opts->commit_bytes) ? opts->commit_bytes
+                                                : WAL_DEFAULT_COMMIT_BYTES;
+    bytes = (bytes + WAL_RECORD_SIZE - 1) / WAL_RECORD_SIZE * WAL_RECORD_SIZE;
+    wal->commit_bytes = bytes;
+    wal->commit_ms = (opts && opts->commit_ms) ? opts->commit_ms
+                                               : WAL_DEFAULT_COMMIT_MS;
+    wal->map = map;
+    wal->ops = ops;
+    wal->buf_len = 0;
+    wal->committed = 0;
+    wal->failed = false;
+    wal->records = 0;
+    wal->commits = 0;
+    wal->replayed = 0;
+    wal->buf = malloc(bytes);
+    // O_APPEND: every write lands at the current end of the log
+    wal->fd = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (!wal->buf || wal->fd < 0 || !wal_replay(wal)) {
+        if (wal->fd >= 0) close(wal->fd);
+        free(wal->buf);
+        free(wal);
+        return NULL;
+    }
+    wal->last_commit_ms = now_ms();
+    return wal;
+}
+
+// Commit buffered records, close the file and free the log
+void wal_close(Wal *wal) {
+    if (!wal) return;
+    wal_commit(wal);  // Best effort, nothing to report to
+    close(wal->fd);
+    free(wal->buf);
+    free(wal);
+}
+
+// Write buffered records and make them durable with one fdatasync
+// On failure the file is cut back to its committed length, dropping any
+// partial write, and the records stay buffered so the commit can be retried
+bool wal_commit(Wal *wal) {
+    if (!wal || wal->failed) return false;
+    wal->last_commit_ms = now_ms();
+    if (wal->buf_len == 0) return true;  // Nothing new since the last commit
+    if (!write_all(wal->fd, wal->buf, wal->buf_len) || fdatasync(wal->fd) != 0) {
+        // Without the cut, later records would follow a torn one and be
+        // dropped by the next replay
+        if (ftruncate(wal->fd, (off_t)wal->committed) != 0) wal->failed = true;
+        return false;
+    }
+    wal->committed += wal->buf_len;
+    wal->buf_len = 0;
+    wal->commits++;
+    return true;
+}
+
+// True once commit_ms have passed since the last commit
+static bool wal_interval_due(Wal *wal) {
+    return wal->commit_ms >= 0 && now_ms() - wal->last_commit_ms >= wal->commit_ms;
+}
+
+// Buffer one record and commit the group if it is due
+static bool wal_append(Wal *wal, uint32_t type, int key, int value) {
+    unsigned char *r = wal->buf + wal->buf_len;
+    store_u32(r, type);
+    store_u32(r + 4, (uint32_t)key);
+    store_u32(r + 8, (uint32_t)value);
+    store_u32(r + 12, record_checksum(type, (uint32_t)key, (uint32_t)value));
+    wal->buf_len += WAL_RECORD_SIZE;
+    wal->records++;
+
+    if (wal->buf_len == wal->commit_bytes || wal_interval_due(wal)) {
+        return wal_commit(wal);
+    }
+    return true;
+}
+
+// Commit buffered records if the interval has passed, without appending
+bool wal_tick(Wal *wal) {
+    if (!wal || wal->failed) return false;
+    if (wal->buf_len > 0 && wal_interval_due(wal)) return wal_commit(wal);
+    return true;
+}
+
+// Make room for one record: a full buffer is left behind by a failed
+// commit, and the operation is refused unless a retry succeeds
+static bool wal_has_room(Wal *wal) {
+    if (wal->failed) return false;
+    return wal->buf_len < wal->commit_bytes || wal_commit(wal);
+}
+
+// Put into the map, then log the record
+bool wal_put(Wal *wal, int key, int value) {
+    if (!wal || !wal_has_room(wal)) return false;
+    if (!wal->ops->put(wal->map, key, value)) return false;  // Not stored, not logged
+    return wal_append(wal, WAL_PUT, key, value);
+}
+
+// Delete from the map, then log the record (absent keys are not logged)
+bool wal_delete(Wal *wal, int key) {
+    if (!wal || !wal_has_room(wal)) return false;
+    if (!wal->ops->del(wal->map, key)) return false;
+    return wal_append(wal, WAL_DELETE, key, 0);
+}
+
+// Return number of successful commits
+size_t wal_commit_count(Wal *wal) {
+    return wal ? wal->commits : 0;
+}
+
+// Return number of records replayed on open
+size_t wal_replay_count(Wal *wal) {
+    return wal ? wal->replayed : 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * Write-Ahead Log Header
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * Class: CS 5008
+ */
+
+#ifndef WAL_H // Include guard
+#define WAL_H // Prevent multiple inclusions
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Bytes per log record (type, key, value, checksum)
+#define WAL_RECORD_SIZE 16
+
+// Buffered bytes that force a commit when the options leave it at 0
+#define WAL_DEFAULT_COMMIT_BYTES (64 * 1024)
+
+// Milliseconds between commits when the options leave it at 0
+#define WAL_DEFAULT_COMMIT_MS 10.0
+
+// Puts gathered into one put_batch call during replay
+#define WAL_REPLAY_BATCH 4096
+
+// Map operations the log drives, so one log works with every map type
+typedef struct {
+    bool (*put)(void *map, int key, int value);  // Insert or update
+    bool (*del)(void *map, int key);             // Delete, true if the key was there
+    size_t (*put_batch)(void *map, const int *keys, const int *values,
+                        size_t n);               // Bulk load used by replay
+} WalMapOps;
+
+// Operations for the three maps
+extern const WalMapOps wal_chained_ops;
+extern const WalMapOps wal_linear_ops;
+extern const WalMapOps wal_cuckoo_ops;
+
+// Group commit settings for wal_open
+// A zeroed struct gives the defaults above. The interval is checked only
+// when a record is appended or wal_tick is called: a caller that goes
+// idle calls wal_tick periodically (or wal_commit) to bound the delay
+typedef struct {
+    size_t commit_bytes;  // Commit once this many bytes are buffered, 0 = WAL_DEFAULT_COMMIT_BYTES
+    double commit_ms;     // Commit when this long has passed since the last one, 0 = WAL_DEFAULT_COMMIT_MS, negative = bytes only
+} WalOptions;
+
+// An open log bound to one map
+typedef struct {
+    int fd;                  // Log file, opened for appending
+    void *map;               // Map every operation is applied to
+    const WalMapOps *ops;    // How to apply them
+    unsigned char *buf;      // Records not yet written
+    size_t buf_len;          // Bytes in buf
+    size_t commit_bytes;     // Buffer size that triggers a commit
+    double commit_ms;        // Time that triggers a commit, negative = off
+    double last_commit_ms;   // When the last commit finished
+    size_t committed;        // Log length in bytes after the last successful commit
+    bool failed;             // A failed commit could not be undone, the log refuses all work
+    size_t records;          // Records appended since open
+    size_t commits;          // Successful commits (one fdatasync each)
+    size_t replayed;         // Records applied to the map by wal_open
+} Wal;
+
+Wal* wal_open(const char *path, void *map, const WalMapOps *ops, const WalOptions *opts); // Open or create a log and replay it into map (opts may be NULL). NULL on failure, including a map that cannot store every record (it then holds part of the log)
+void wal_close(Wal *wal); // Commit, close the file and free the log (the map is kept)
+bool wal_put(Wal *wal, int key, int value); // Put into the map and log it. False if the put or a commit failed (the record stays buffered), or if a full buffer cannot be committed (nothing is done)
+bool wal_delete(Wal *wal, int key); // Delete from the map and log it. False if the key was absent or as for wal_put
+bool wal_commit(Wal *wal); // Write buffered records and fdatasync now. On failure the file is cut back and the records stay buffered for a retry
+bool wal_tick(Wal *wal); // Commit if records are buffered and commit_ms have passed. False if that commit failed
+size_t wal_commit_count(Wal *wal); // Get number of successful commits
+size_t wal_replay_count(Wal *wal); // Get number of records replayed on open
+
+#endif